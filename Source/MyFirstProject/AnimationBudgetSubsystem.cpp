@@ -0,0 +1,206 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "AnimationBudgetSubsystem.h"
+#include "Engine/World.h"
+#include "Kismet/GameplayStatics.h"
+#include "GameFramework/Pawn.h"
+#include "Enemy.h"
+#include "EnemyMeshComponent.h"
+
+static TAutoConsoleVariable<float> CVarEnemyAnimBudget(
+	TEXT("anim.EnemyBudgetMs"),
+	1.5f,
+	TEXT("Game thread milliseconds per frame for enemy skeletal mesh ticks, 0 lets every enemy mesh update at its own rate"));
+
+static FAutoConsoleCommandWithWorld AnimBudgetStatsCommand(
+	TEXT("AnimBudget.Stats"),
+	TEXT("Print how much of the enemy animation budget the last frame used and how the meshes were throttled"),
+	FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+{
+	if (World)
+	{
+		if (UAnimationBudgetSubsystem* Budget = World->GetSubsystem<UAnimationBudgetSubsystem>())
+		{
+			Budget->LogStats();
+		}
+	}
+}));
+
+UAnimationBudgetSubsystem::UAnimationBudgetSubsystem()
+{
+	MaxUpdateRate = 8;
+	MaxInterpolatedRate = 4;
+
+	FrameMs = 0.f;
+}
+
+bool UAnimationBudgetSubsystem::IsEnabled()
+{
+	return CVarEnemyAnimBudget.GetValueOnGameThread() > 0.f;
+}
+
+void UAnimationBudgetSubsystem::Deinitialize()
+{
+	Enemies.Empty();
+
+	Super::Deinitialize();
+}
+
+bool UAnimationBudgetSubsystem::IsTickable() const
+{
+	return Enemies.Num() > 0 && Super::IsTickable();
+}
+
+void UAnimationBudgetSubsystem::Register(AEnemy* Enemy)
+{
+	if (Enemy && Cast<UEnemyMeshComponent>(Enemy->GetMesh()))
+	{
+		Enemies.AddUnique(Enemy);
+	}
+}
+
+void UAnimationBudgetSubsystem::Unregister(AEnemy* Enemy)
+{
+	if (Enemies.RemoveSingleSwap(Enemy, false) > 0)
+	{
+		ReleaseMesh(Enemy);
+	}
+}
+
+void UAnimationBudgetSubsystem::ReleaseMesh(AEnemy* Enemy)
+{
+	if (USkeletalMeshComponent* Mesh = Enemy->GetMesh())
+	{
+		Mesh->EnableExternalTickRateControl(false);
+		Mesh->EnableExternalInterpolation(false);
+	}
+}
+
+void UAnimationBudgetSubsystem::Tick(float DeltaTime)
+{
+	/// the enemy meshes ticked earlier this frame
+	Stats.UsedMs = FrameMs;
+	Stats.AverageUsedMs = FMath::Lerp(Stats.AverageUsedMs, FrameMs, 0.05f);
+	FrameMs = 0.f;
+
+	Allocate();
+}
+
+void UAnimationBudgetSubsystem::Allocate()
+{
+	const float BudgetMs = CVarEnemyAnimBudget.GetValueOnGameThread();
+	Stats.BudgetMs = BudgetMs;
+
+	if (BudgetMs <= 0.f)
+	{
+		for (const TWeakObjectPtr<AEnemy>& Enemy : Enemies)
+		{
+			if (Enemy.IsValid())
+			{
+				ReleaseMesh(Enemy.Get());
+			}
+		}
+		return;
+	}
+
+	APawn* Player = UGameplayStatics::GetPlayerPawn(GetWorld(), 0);
+	const FVector ViewLocation = Player ? Player->GetActorLocation() : FVector::ZeroVector;
+
+	struct FCandidate
+	{
+		UEnemyMeshComponent* Mesh;
+		/// lower is more significant
+		float Priority;
+		bool bVisible;
+		int32 Rate;
+	};
+
+	TArray<FCandidate, TInlineAllocator<64>> Candidates;
+
+	float PlannedMs = 0.f;
+	int32 Exempt = 0;
+
+	for (int32 i = Enemies.Num() - 1; i >= 0; i--)
+	{
+		AEnemy* Enemy = Enemies[i].Get();
+
+		if (!Enemy)
+		{
+			Enemies.RemoveAtSwap(i, 1, false);
+			continue;
+		}
+
+		UEnemyMeshComponent* Mesh = static_cast<UEnemyMeshComponent*>(Enemy->GetMesh());
+		if (!Mesh->IsComponentTickEnabled()) continue; /// pooled
+
+		Mesh->EnableExternalTickRateControl(true);
+
+		if (Enemy->bAttacking || Enemy->bOverlappingCombatSphere) /// a throttled swing would hit late or look choppy up close
+		{
+			Mesh->SetExternalTickRate(1);
+			Mesh->EnableExternalInterpolation(false);
+			PlannedMs += Mesh->FullUpdateMs;
+			Exempt++;
+			continue;
+		}
+
+		const bool bVisible = Mesh->WasRecentlyRendered(0.2f);
+		const float Distance = FVector::Dist(Enemy->GetActorLocation(), ViewLocation);
+
+		/// off screen enemies rank as if they were four times farther
+		Candidates.Add({ Mesh, bVisible ? Distance : Distance * 4.f, bVisible, 1 });
+		PlannedMs += Mesh->FullUpdateMs;
+	}
+
+	Candidates.Sort([](const FCandidate& A, const FCandidate& B) { return A.Priority < B.Priority; });
+
+	auto CostAtRate = [](const UEnemyMeshComponent* Mesh, int32 Rate)
+	{
+		return (Mesh->FullUpdateMs + Mesh->SkippedUpdateMs * (Rate - 1)) / Rate;
+	};
+
+	/// slow down the least significant enemies one step at a time until the estimate fits
+	for (int32 Rate = 2; Rate <= MaxUpdateRate && PlannedMs > BudgetMs; Rate++)
+	{
+		for (int32 i = Candidates.Num() - 1; i >= 0 && PlannedMs > BudgetMs; i--)
+		{
+			FCandidate& Candidate = Candidates[i];
+
+			PlannedMs -= CostAtRate(Candidate.Mesh, Candidate.Rate) - CostAtRate(Candidate.Mesh, Rate);
+			Candidate.Rate = Rate;
+		}
+	}
+
+	Stats.PlannedMs = PlannedMs;
+	Stats.Meshes = Candidates.Num() + Exempt;
+	Stats.Exempt = Exempt;
+	Stats.FullRate = 0;
+	Stats.Interpolated = 0;
+	Stats.Skipped = 0;
+
+	for (const FCandidate& Candidate : Candidates)
+	{
+		const bool bInterpolate = Candidate.Rate > 1 && Candidate.bVisible && Candidate.Rate <= MaxInterpolatedRate;
+
+		Candidate.Mesh->SetExternalTickRate(Candidate.Rate);
+		Candidate.Mesh->EnableExternalInterpolation(bInterpolate);
+
+		if (Candidate.Rate == 1)
+		{
+			Stats.FullRate++;
+		} else if (bInterpolate)
+		{
+			Stats.Interpolated++;
+		} else
+		{
+			Stats.Skipped++;
+		}
+	}
+}
+
+void UAnimationBudgetSubsystem::LogStats() const
+{
+	UE_LOG(LogTemp, Log, TEXT("Enemy animation budget: %.3f of %.2fms used last frame (%.0f%%), %.3fms on average, %.3fms planned, %d meshes: %d exempt, %d full rate, %d interpolated, %d skipped"),
+		Stats.UsedMs, Stats.BudgetMs, Stats.BudgetMs > 0.f ? Stats.UsedMs / Stats.BudgetMs * 100.f : 0.f, Stats.AverageUsedMs, Stats.PlannedMs,
+		Stats.Meshes, Stats.Exempt, Stats.FullRate, Stats.Interpolated, Stats.Skipped);
+}
\ No newline at end of file
@@ -0,0 +1,105 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "TickableGameplaySubsystem.h"
+#include "AnimationBudgetSubsystem.generated.h"
+
+/// How the enemy animation budget was spent last frame
+USTRUCT(BlueprintType)
+struct FAnimationBudgetStats
+{
+	GENERATED_BODY()
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Animation")
+		float BudgetMs = 0.f;
+
+	/// Measured game thread time of every enemy mesh tick last frame
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Animation")
+		float UsedMs = 0.f;
+
+	/// UsedMs smoothed over the last frames
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Animation")
+		float AverageUsedMs = 0.f;
+
+	/// Cost the allocation expected for this frame
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Animation")
+		float PlannedMs = 0.f;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Animation")
+		int32 Meshes = 0;
+
+	/// Attacking or in combat range, always updated every frame
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Animation")
+		int32 Exempt = 0;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Animation")
+		int32 FullRate = 0;
+
+	/// Updated every few frames and interpolated in between
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Animation")
+		int32 Interpolated = 0;
+
+	/// Updated every few frames and frozen in between
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Animation")
+		int32 Skipped = 0;
+};
+
+/**
+ * Keeps enemy skeletal mesh ticks within a fixed number of milliseconds per frame. Enemies are ranked by distance
+ * and visibility, the least significant ones update their animation every few frames, interpolated on screen and
+ * frozen in between off screen, until the estimated cost fits the budget. Attacking enemies and enemies in
+ * combat range always update every frame
+ */
+UCLASS()
+class MYFIRSTPROJECT_API UAnimationBudgetSubsystem: public UTickableGameplaySubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	UAnimationBudgetSubsystem();
+
+	/// Update at most every this many frames
+	int32 MaxUpdateRate;
+
+	/// Rates up to this one interpolate the skipped frames on screen, slower ones would look like sliding
+	int32 MaxInterpolatedRate;
+
+	/// The budget is on (anim.EnemyBudgetMs above 0), the significance tiers leave the mesh tick interval alone then
+	static bool IsEnabled();
+
+	virtual void Deinitialize() override;
+
+	virtual void Tick(float DeltaTime) override;
+
+	virtual bool IsTickable() const override;
+
+	void Register(class AEnemy* Enemy);
+
+	/// Give the enemy's mesh back its own update rate
+	void Unregister(AEnemy* Enemy);
+
+	/// Called by every enemy mesh after its tick
+	void AddTickCost(float Ms) { FrameMs += Ms; }
+
+	UFUNCTION(BlueprintPure, Category = "Animation")
+		FAnimationBudgetStats GetStats() const { return Stats; }
+
+	void LogStats() const;
+
+private:
+
+	/// rank the enemies and pick the update rate of each for the next frame
+	void Allocate();
+
+	static void ReleaseMesh(AEnemy* Enemy);
+
+	TArray<TWeakObjectPtr<AEnemy>> Enemies;
+
+	/// mesh tick time added up during the current frame
+	float FrameMs;
+
+	FAnimationBudgetStats Stats;
+};
@@ -0,0 +1,274 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "AssetPreloadSubsystem.h"
+#include "Engine/AssetManager.h"
+#include "Engine/StreamableManager.h"
+#include "Engine/World.h"
+#include "Kismet/GameplayStatics.h"
+#include "GameFramework/Pawn.h"
+#include "UObject/UnrealType.h"
+#include "SpawnVolume.h"
+
+static FAutoConsoleCommandWithWorld PreloadReportCommand(
+	TEXT("Preload.Report"),
+	TEXT("List every archetype known to the asset preloader with its state, users and resident memory"),
+	FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+{
+	if (World)
+	{
+		if (UAssetPreloadSubsystem* Preload = World->GetSubsystem<UAssetPreloadSubsystem>())
+		{
+			Preload->LogReport();
+		}
+	}
+}));
+
+UAssetPreloadSubsystem::UAssetPreloadSubsystem()
+{
+	RelevanceRadius = 6000.f;
+	RefreshInterval = 0.5f;
+
+	TimeSinceRefresh = 0.f;
+}
+
+void UAssetPreloadSubsystem::Deinitialize()
+{
+	for (auto& Pair : Archetypes)
+	{
+		if (Pair.Value.Handle.IsValid())
+		{
+			Pair.Value.Handle->CancelHandle();
+		}
+		for (auto& Instance : Pair.Value.Instances)
+		{
+			if (Instance.Value.IsValid())
+			{
+				Instance.Value->CancelHandle();
+			}
+		}
+	}
+
+	Archetypes.Empty();
+	Spawners.Empty();
+
+	Super::Deinitialize();
+}
+
+bool UAssetPreloadSubsystem::IsTickable() const
+{
+	return Spawners.Num() > 0 && Super::IsTickable();
+}
+
+void UAssetPreloadSubsystem::Tick(float DeltaTime)
+{
+	TimeSinceRefresh += DeltaTime;
+	if (TimeSinceRefresh < RefreshInterval) return;
+
+	TimeSinceRefresh = 0.f;
+	RefreshSpawners();
+}
+
+void UAssetPreloadSubsystem::RegisterSpawner(ASpawnVolume* Spawner)
+{
+	if (!Spawner) return;
+
+	Spawners.AddUnique(Spawner);
+	TimeSinceRefresh = RefreshInterval; /// check it on the next tick
+}
+
+void UAssetPreloadSubsystem::UnregisterSpawner(ASpawnVolume* Spawner)
+{
+	Spawners.Remove(Spawner);
+	TimeSinceRefresh = RefreshInterval;
+}
+
+void UAssetPreloadSubsystem::AddInstance(AActor* Actor)
+{
+	if (!Actor) return;
+
+	FArchetypeAssets& Assets = FindOrAddArchetype(Actor->GetClass());
+	if (Assets.Instances.Contains(Actor)) return;
+
+	/// values edited on the placed actor aren't on the class defaults, load them for this instance only
+	TArray<FSoftObjectPath> Overrides;
+	CollectSoftPaths(Actor, Overrides);
+	Overrides.RemoveAll([&Assets](const FSoftObjectPath& Path) { return Assets.Paths.Contains(Path); });
+
+	TSharedPtr<FStreamableHandle> OverridesHandle;
+	if (Overrides.Num() > 0)
+	{
+		OverridesHandle = UAssetManager::GetStreamableManager().RequestAsyncLoad(Overrides);
+	}
+
+	Assets.Instances.Add(Actor, OverridesHandle);
+	UpdateArchetype(Actor->GetClass(), Assets);
+}
+
+void UAssetPreloadSubsystem::RemoveInstance(AActor* Actor)
+{
+	if (!Actor) return;
+
+	if (FArchetypeAssets* Assets = Archetypes.Find(Actor->GetClass()))
+	{
+		TSharedPtr<FStreamableHandle> OverridesHandle;
+		if (Assets->Instances.RemoveAndCopyValue(Actor, OverridesHandle) && OverridesHandle.IsValid())
+		{
+			OverridesHandle->ReleaseHandle();
+		}
+		UpdateArchetype(Actor->GetClass(), *Assets);
+	}
+}
+
+UAssetPreloadSubsystem::FArchetypeAssets& UAssetPreloadSubsystem::FindOrAddArchetype(UClass* Archetype)
+{
+	if (FArchetypeAssets* Existing = Archetypes.Find(Archetype))
+	{
+		return *Existing;
+	}
+
+	FArchetypeAssets& Assets = Archetypes.Add(Archetype);
+
+	/// every soft object reference of the class defaults, blueprint overrides included
+	CollectSoftPaths(Archetype->GetDefaultObject(), Assets.Paths);
+
+	return Assets;
+}
+
+void UAssetPreloadSubsystem::CollectSoftPaths(const UObject* Object, TArray<FSoftObjectPath>& OutPaths)
+{
+	for (TFieldIterator<FSoftObjectProperty> It(Object->GetClass()); It; ++It)
+	{
+		if (It->IsA<FSoftClassProperty>()) continue; /// classes are loaded by whoever spawns them
+
+		for (int32 i = 0; i < It->ArrayDim; i++)
+		{
+			const FSoftObjectPath Path = It->GetPropertyValue_InContainer(Object, i).ToSoftObjectPath();
+			if (Path.IsValid())
+			{
+				OutPaths.AddUnique(Path);
+			}
+		}
+	}
+}
+
+void UAssetPreloadSubsystem::UpdateArchetype(UClass* Archetype, FArchetypeAssets& Assets)
+{
+	for (auto It = Assets.Instances.CreateIterator(); It; ++It)
+	{
+		if (!It->Key.IsValid()) /// destroyed without RemoveInstance
+		{
+			if (It->Value.IsValid())
+			{
+				It->Value->ReleaseHandle();
+			}
+			It.RemoveCurrent();
+		}
+	}
+
+	const bool bWanted = Assets.RelevantSpawners > 0 || Assets.Instances.Num() > 0;
+
+	if (bWanted && !Assets.Handle.IsValid() && Assets.Paths.Num() > 0)
+	{
+		Assets.LoadStartTime = FPlatformTime::Seconds();
+		Assets.LoadSeconds = 0.f;
+
+		Assets.Handle = UAssetManager::GetStreamableManager().RequestAsyncLoad(Assets.Paths, FStreamableDelegate::CreateWeakLambda(this, [this, Archetype]()
+		{
+			if (FArchetypeAssets* Loaded = Archetypes.Find(Archetype))
+			{
+				Loaded->LoadSeconds = FPlatformTime::Seconds() - Loaded->LoadStartTime;
+			}
+		}));
+	} else if (!bWanted && Assets.Handle.IsValid())
+	{
+		Assets.Handle->ReleaseHandle(); /// nothing else references them, the next garbage collection frees them
+		Assets.Handle.Reset();
+	}
+}
+
+void UAssetPreloadSubsystem::RefreshSpawners()
+{
+	APawn* Player = UGameplayStatics::GetPlayerPawn(GetWorld(), 0);
+	const float RadiusSquared = RelevanceRadius * RelevanceRadius;
+
+	TMap<UClass*, int32> Relevant;
+
+	for (int32 i = Spawners.Num() - 1; i >= 0; i--)
+	{
+		ASpawnVolume* Spawner = Spawners[i].Get();
+		if (!Spawner)
+		{
+			Spawners.RemoveAtSwap(i);
+			continue;
+		}
+
+		if (!Player || FVector::DistSquared(Player->GetActorLocation(), Spawner->GetActorLocation()) > RadiusSquared) continue;
+
+		for (const TSubclassOf<AActor>& SpawnClass : Spawner->SpawnArray)
+		{
+			if (SpawnClass)
+			{
+				Relevant.FindOrAdd(*SpawnClass)++;
+			}
+		}
+	}
+
+	for (const auto& Pair : Relevant)
+	{
+		FindOrAddArchetype(Pair.Key);
+	}
+
+	for (auto& Pair : Archetypes)
+	{
+		const int32* Count = Relevant.Find(Pair.Key);
+		const int32 RelevantSpawners = Count ? *Count : 0;
+
+		if (RelevantSpawners != Pair.Value.RelevantSpawners)
+		{
+			Pair.Value.RelevantSpawners = RelevantSpawners;
+			UpdateArchetype(Pair.Key, Pair.Value);
+		}
+	}
+}
+
+bool UAssetPreloadSubsystem::IsResident(UClass* Archetype) const
+{
+	const FArchetypeAssets* Assets = Archetypes.Find(Archetype);
+	return Assets && Assets->Handle.IsValid() && Assets->Handle->HasLoadCompleted();
+}
+
+int64 UAssetPreloadSubsystem::GetResidentBytes(UClass* Archetype) const
+{
+	const FArchetypeAssets* Assets = Archetypes.Find(Archetype);
+	if (!Assets) return 0;
+
+	int64 Bytes = 0;
+	for (const FSoftObjectPath& Path : Assets->Paths)
+	{
+		if (UObject* Asset = Path.ResolveObject())
+		{
+			Bytes += Asset->GetResourceSizeBytes(EResourceSizeMode::EstimatedTotal);
+		}
+	}
+	return Bytes;
+}
+
+void UAssetPreloadSubsystem::LogReport() const
+{
+	UE_LOG(LogTemp, Log, TEXT("%-40s %9s %6s %9s %9s %10s %12s"), TEXT("Archetype"), TEXT("State"), TEXT("Assets"), TEXT("Instances"), TEXT("Spawners"), TEXT("Load s"), TEXT("Resident KB"));
+
+	int64 TotalBytes = 0;
+
+	for (const auto& Pair : Archetypes)
+	{
+		const FArchetypeAssets& Assets = Pair.Value;
+
+		const TCHAR* State = !Assets.Handle.IsValid() ? TEXT("Released") : Assets.Handle->HasLoadCompleted() ? TEXT("Resident") : TEXT("Loading");
+		const int64 Bytes = GetResidentBytes(Pair.Key); /// released assets count until garbage collection frees them
+		TotalBytes += Bytes;
+
+		UE_LOG(LogTemp, Log, TEXT("%-40s %9s %6d %9d %9d %10.3f %12.1f"), *Pair.Key->GetName(), State, Assets.Paths.Num(), Assets.Instances.Num(), Assets.RelevantSpawners, Assets.LoadSeconds, Bytes / 1024.f);
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("%d archetypes, %.1f KB resident"), Archetypes.Num(), TotalBytes / 1024.f);
+}
\ No newline at end of file
@@ -0,0 +1,86 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "TickableGameplaySubsystem.h"
+#include "AssetPreloadSubsystem.generated.h"
+
+/**
+ * Streams in the soft-referenced FX, sounds and montages of an archetype (the class of an enemy, weapon or the player)
+ * while a spawner of it is near the player or an instance of it is alive, and lets them unload once neither is true
+ */
+UCLASS()
+class MYFIRSTPROJECT_API UAssetPreloadSubsystem: public UTickableGameplaySubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	UAssetPreloadSubsystem();
+
+	/// Spawners closer than this to the player keep the assets of what they spawn loaded
+	float RelevanceRadius;
+
+	/// Seconds between spawner relevance checks
+	float RefreshInterval;
+
+	virtual void Deinitialize() override;
+
+	virtual void Tick(float DeltaTime) override;
+
+	virtual bool IsTickable() const override;
+
+	/// A spawner whose spawn classes should be loaded while it's near the player
+	void RegisterSpawner(class ASpawnVolume* Spawner);
+
+	void UnregisterSpawner(ASpawnVolume* Spawner);
+
+	/// Keep the assets of the actor's class, and the ones overridden on the actor itself, loaded until RemoveInstance, calling it again does nothing
+	void AddInstance(AActor* Actor);
+
+	void RemoveInstance(AActor* Actor);
+
+	/// Every soft object reference set on the class defaults has finished loading
+	bool IsResident(UClass* Archetype) const;
+
+	/// Memory used by the loaded assets of the archetype
+	int64 GetResidentBytes(UClass* Archetype) const;
+
+	void LogReport() const;
+
+private:
+
+	struct FArchetypeAssets
+	{
+		/// soft object references found on the class defaults
+		TArray<FSoftObjectPath> Paths;
+
+		TSharedPtr<struct FStreamableHandle> Handle;
+
+		/// live instances with the handle of the references they override in the level, null if they override none
+		TMap<TWeakObjectPtr<AActor>, TSharedPtr<struct FStreamableHandle>> Instances;
+
+		int32 RelevantSpawners = 0;
+
+		double LoadStartTime = 0.0;
+		float LoadSeconds = 0.f;
+	};
+
+	FArchetypeAssets& FindOrAddArchetype(UClass* Archetype);
+
+	/// soft object references set on Object, soft class references left out
+	static void CollectSoftPaths(const UObject* Object, TArray<FSoftObjectPath>& OutPaths);
+
+	/// request or release the archetype's assets after its counts changed
+	void UpdateArchetype(UClass* Archetype, FArchetypeAssets& Assets);
+
+	/// count the spawners near the player for every archetype
+	void RefreshSpawners();
+
+	TMap<UClass*, FArchetypeAssets> Archetypes;
+
+	TArray<TWeakObjectPtr<ASpawnVolume>> Spawners;
+
+	float TimeSinceRefresh;
+};
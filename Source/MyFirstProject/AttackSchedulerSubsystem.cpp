@@ -0,0 +1,162 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "AttackSchedulerSubsystem.h"
+#include "Engine/World.h"
+#include "Enemy.h"
+
+static FAutoConsoleCommandWithWorld AttackStatsCommand(
+	TEXT("Attack.Stats"),
+	TEXT("Print the attack scheduler queue and token counters"),
+	FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+{
+	if (World)
+	{
+		if (UAttackSchedulerSubsystem* Scheduler = World->GetSubsystem<UAttackSchedulerSubsystem>())
+		{
+			Scheduler->LogStats();
+		}
+	}
+}));
+
+UAttackSchedulerSubsystem::UAttackSchedulerSubsystem()
+{
+	MaxTokens = 2;
+	RetryDelay = 0.3f;
+	TokenTimeout = 5.f;
+
+	NextSerial = 1;
+}
+
+void UAttackSchedulerSubsystem::Deinitialize()
+{
+	Queue.Empty();
+	Serials.Empty();
+	TokenHolders.Empty();
+
+	Super::Deinitialize();
+}
+
+bool UAttackSchedulerSubsystem::IsTickable() const
+{
+	return (Queue.Num() > 0 || TokenHolders.Num() > 0) && Super::IsTickable();
+}
+
+void UAttackSchedulerSubsystem::ScheduleAttack(AEnemy* Enemy, float Delay)
+{
+	if (!Enemy) return;
+
+	const float Now = GetWorld()->GetTimeSeconds();
+
+	FPendingAttack Attack;
+	Attack.DueTime = Now + FMath::Max(Delay, 0.f);
+	Attack.FirstDueTime = Attack.DueTime;
+	Attack.Enemy = Enemy;
+	Attack.Serial = NextSerial++;
+
+	if (Serials.Contains(Enemy))
+	{
+		Stats.Cancelled++; /// the old entry goes stale
+	}
+	Serials.Add(Enemy, Attack.Serial);
+
+	Queue.HeapPush(Attack);
+}
+
+void UAttackSchedulerSubsystem::CancelAttack(AEnemy* Enemy)
+{
+	if (Serials.Remove(Enemy) > 0)
+	{
+		Stats.Cancelled++;
+	}
+}
+
+void UAttackSchedulerSubsystem::ReleaseToken(AEnemy* Enemy)
+{
+	TokenHolders.Remove(Enemy);
+}
+
+bool UAttackSchedulerSubsystem::WantsToAttack(AEnemy* Enemy)
+{
+	return Enemy && Enemy->Alive() && Enemy->bOverlappingCombatSphere && Enemy->bHasValidTarget;
+}
+
+void UAttackSchedulerSubsystem::Tick(float DeltaTime)
+{
+	const float Now = GetWorld()->GetTimeSeconds();
+
+	for (auto It = TokenHolders.CreateIterator(); It; ++It)
+	{
+		AEnemy* Holder = It->Key.Get();
+		if (!Holder || !Holder->bAttacking || Now - It->Value > TokenTimeout) /// gone, interrupted or stuck without AttackEnd
+		{
+			if (Holder && Holder->bAttacking)
+			{
+				Stats.Expired++;
+			}
+			It.RemoveCurrent();
+		}
+	}
+
+	TArray<FPendingAttack, TInlineAllocator<8>> Retry;
+
+	while (Queue.Num() > 0 && Queue.HeapTop().DueTime <= Now)
+	{
+		FPendingAttack Attack;
+		Queue.HeapPop(Attack, false);
+
+		const uint32* Serial = Serials.Find(Attack.Enemy);
+		if (!Serial || *Serial != Attack.Serial) continue; /// rescheduled or cancelled since
+
+		AEnemy* Enemy = Attack.Enemy.Get();
+		if (!WantsToAttack(Enemy))
+		{
+			Serials.Remove(Attack.Enemy);
+			Stats.Cancelled++;
+			continue;
+		}
+
+		if (TokenHolders.Num() >= MaxTokens && !TokenHolders.Contains(Enemy))
+		{
+			/// every token is taken, come back a bit later, jittered so the waiting enemies don't all retry together
+			Attack.DueTime = Now + RetryDelay * FMath::FRandRange(0.75f, 1.25f);
+			Retry.Add(Attack);
+			Stats.Deferred++;
+			continue;
+		}
+
+		Serials.Remove(Attack.Enemy);
+		Stats.MaxTokenWait = FMath::Max(Stats.MaxTokenWait, Now - Attack.FirstDueTime);
+
+		TokenHolders.Add(Enemy, Now);
+		Enemy->Attack();
+
+		if (Enemy->bAttacking)
+		{
+			Stats.Granted++;
+		} else
+		{
+			TokenHolders.Remove(Enemy); /// couldn't start its attack after all
+		}
+	}
+
+	for (const FPendingAttack& Attack : Retry)
+	{
+		Queue.HeapPush(Attack);
+	}
+}
+
+FAttackSchedulerStats UAttackSchedulerSubsystem::GetStats() const
+{
+	FAttackSchedulerStats Current = Stats;
+	Current.Pending = Serials.Num();
+	Current.TokensInUse = TokenHolders.Num();
+	return Current;
+}
+
+void UAttackSchedulerSubsystem::LogStats() const
+{
+	const FAttackSchedulerStats Current = GetStats();
+
+	UE_LOG(LogTemp, Log, TEXT("Attack scheduler: %d pending (%d queue entries), %d/%d tokens in use, %d granted, %d deferred, %d cancelled, %d expired, longest wait for a token %.2fs"),
+		Current.Pending, Queue.Num(), Current.TokensInUse, MaxTokens, Current.Granted, Current.Deferred, Current.Cancelled, Current.Expired, Current.MaxTokenWait);
+}
\ No newline at end of file
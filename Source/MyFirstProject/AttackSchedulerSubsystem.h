@@ -0,0 +1,115 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "TickableGameplaySubsystem.h"
+#include "AttackSchedulerSubsystem.generated.h"
+
+/// Counters reported by the attack scheduler
+USTRUCT(BlueprintType)
+struct FAttackSchedulerStats
+{
+	GENERATED_BODY()
+
+	/// Attacks waiting for their time or for a token
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Combat")
+		int32 Pending = 0;
+
+	/// Enemies attacking right now
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Combat")
+		int32 TokensInUse = 0;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Combat")
+		int32 Granted = 0;
+
+	/// Due attacks pushed back because every token was taken
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Combat")
+		int32 Deferred = 0;
+
+	/// Scheduled attacks dropped because the enemy left, died or was rescheduled
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Combat")
+		int32 Cancelled = 0;
+
+	/// Tokens taken back from enemies that never finished their attack
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Combat")
+		int32 Expired = 0;
+
+	/// Longest time a due attack waited for a token, in seconds
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Combat")
+		float MaxTokenWait = 0.f;
+};
+
+/**
+ * Decides when enemies in combat range attack, instead of one timer per enemy
+ * Pending attacks sit in a queue ordered by due time, all due ones are handled in one pass per frame
+ * and only MaxTokens enemies may attack at once, the rest wait their turn
+ */
+UCLASS()
+class MYFIRSTPROJECT_API UAttackSchedulerSubsystem: public UTickableGameplaySubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	UAttackSchedulerSubsystem();
+
+	/// Enemies allowed to attack at the same time
+	int32 MaxTokens;
+
+	/// Delay before a due attack that found no free token tries again
+	float RetryDelay;
+
+	/// Seconds after which a token is taken back if AttackEnd never came
+	float TokenTimeout;
+
+	virtual void Deinitialize() override;
+
+	virtual void Tick(float DeltaTime) override;
+
+	virtual bool IsTickable() const override;
+
+	/// Attack in Delay seconds, replaces an attack already scheduled for the enemy
+	void ScheduleAttack(class AEnemy* Enemy, float Delay);
+
+	/// Forget the enemy's scheduled attack
+	void CancelAttack(AEnemy* Enemy);
+
+	/// The enemy's attack is over, its token goes to the next one in line
+	void ReleaseToken(AEnemy* Enemy);
+
+	UFUNCTION(BlueprintPure, Category = "Combat")
+		FAttackSchedulerStats GetStats() const;
+
+	void LogStats() const;
+
+private:
+
+	struct FPendingAttack
+	{
+		float DueTime;
+		/// time the attack first became due, to measure the wait for a token
+		float FirstDueTime;
+		TWeakObjectPtr<AEnemy> Enemy;
+		/// stale once the enemy got rescheduled or cancelled
+		uint32 Serial;
+
+		bool operator<(const FPendingAttack& Other) const { return DueTime < Other.DueTime; }
+	};
+
+	/// can the enemy still use an attack it scheduled
+	static bool WantsToAttack(AEnemy* Enemy);
+
+	/// pending attacks, earliest due time on top, entries removed lazily through Serials
+	TArray<FPendingAttack> Queue;
+
+	/// serial of the live queue entry of each enemy
+	TMap<TWeakObjectPtr<AEnemy>, uint32> Serials;
+
+	/// world time each token holder started its attack
+	TMap<TWeakObjectPtr<AEnemy>, float> TokenHolders;
+
+	uint32 NextSerial;
+
+	FAttackSchedulerStats Stats;
+};
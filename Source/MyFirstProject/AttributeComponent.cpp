@@ -0,0 +1,120 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "AttributeComponent.h"
+#include "Engine/World.h"
+#include "TimerManager.h"
+
+UAttributeComponent::UAttributeComponent()
+{
+	PrimaryComponentTick.bCanEverTick = false;
+
+	MinValue = 0.f;
+	MaxValue = 100.f;
+
+	BaseValue = 0.f;
+	BaseTime = 0.f;
+	Rate = 0.f;
+	PendingThreshold = 0.f;
+}
+
+void UAttributeComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UWorld* World = GetWorld())
+	{
+		World->GetTimerManager().ClearTimer(ThresholdTimer);
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
+float UAttributeComponent::GetTime() const
+{
+	UWorld* World = GetWorld();
+	return World ? World->GetTimeSeconds() : 0.f;
+}
+
+float UAttributeComponent::GetValue() const
+{
+	return FMath::Clamp(BaseValue + Rate * (GetTime() - BaseTime), MinValue, MaxValue);
+}
+
+void UAttributeComponent::SetValue(float Value)
+{
+	BaseValue = FMath::Clamp(Value, MinValue, MaxValue);
+	BaseTime = GetTime();
+
+	ScheduleNextThreshold();
+}
+
+void UAttributeComponent::SetRate(float NewRate)
+{
+	if (NewRate == Rate) return; /// called every time the owner re-evaluates, keep the running timer
+
+	Rebase();
+	Rate = NewRate;
+
+	ScheduleNextThreshold();
+}
+
+void UAttributeComponent::SetRange(float NewMin, float NewMax)
+{
+	Rebase();
+	MinValue = NewMin;
+	MaxValue = FMath::Max(NewMin, NewMax);
+	BaseValue = FMath::Clamp(BaseValue, MinValue, MaxValue);
+
+	ScheduleNextThreshold();
+}
+
+bool UAttributeComponent::IsChanging() const
+{
+	if (Rate > 0.f) return GetValue() < MaxValue;
+	if (Rate < 0.f) return GetValue() > MinValue;
+	return false;
+}
+
+void UAttributeComponent::Rebase()
+{
+	BaseValue = GetValue();
+	BaseTime = GetTime();
+}
+
+void UAttributeComponent::ScheduleNextThreshold()
+{
+	UWorld* World = GetWorld();
+	if (!World) return;
+
+	World->GetTimerManager().ClearTimer(ThresholdTimer);
+
+	if (Rate == 0.f) return;
+
+	const float Value = GetValue();
+	float Next = Rate > 0.f ? MaxValue : MinValue;
+
+	for (float Threshold : Thresholds) /// closest threshold ahead of the value in the direction it moves
+	{
+		if (Rate > 0.f ? (Threshold > Value && Threshold < Next) : (Threshold < Value && Threshold > Next))
+		{
+			Next = Threshold;
+		}
+	}
+
+	if (Rate > 0.f ? Value >= Next : Value <= Next) return; /// already pinned at a bound
+
+	PendingThreshold = Next;
+	World->GetTimerManager().SetTimer(ThresholdTimer, this, &UAttributeComponent::OnThresholdReached, FMath::Max((Next - Value) / Rate, KINDA_SMALL_NUMBER), false);
+}
+
+void UAttributeComponent::OnThresholdReached()
+{
+	const float Threshold = PendingThreshold;
+	const bool bRising = Rate > 0.f;
+
+	/// snap so timer granularity can't leave the value just short of the threshold and fire it again
+	BaseValue = Threshold;
+	BaseTime = GetTime();
+
+	ScheduleNextThreshold();
+
+	OnThresholdCrossed.Broadcast(this, Threshold, bRising);
+}
\ No newline at end of file
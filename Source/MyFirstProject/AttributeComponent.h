@@ -0,0 +1,83 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "AttributeComponent.generated.h"
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_ThreeParams(FOnAttributeThresholdCrossed, class UAttributeComponent*, Attribute, float, Threshold, bool, bRising);
+
+/**
+ * Value that changes at a constant rate (stamina drain, health regen) without ticking
+ * Only the value at a timestamp and the rate are stored, the current value is computed when read
+ * and a single timer fires when the next threshold or bound is reached
+ */
+UCLASS(ClassGroup = (Custom), meta = (BlueprintSpawnableComponent))
+class MYFIRSTPROJECT_API UAttributeComponent: public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+
+	UAttributeComponent();
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Attribute")
+		float MinValue;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Attribute")
+		float MaxValue;
+
+	/// Values between MinValue and MaxValue that fire OnThresholdCrossed when the value moves through them
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Attribute")
+		TArray<float> Thresholds;
+
+	/// Fired when the value reaches a threshold, MinValue or MaxValue while changing
+	UPROPERTY(BlueprintAssignable, Category = "Attribute")
+		FOnAttributeThresholdCrossed OnThresholdCrossed;
+
+	UFUNCTION(BlueprintPure, Category = "Attribute")
+		float GetValue() const;
+
+	UFUNCTION(BlueprintPure, Category = "Attribute")
+		float GetRate() const { return Rate; }
+
+	/// Set the value directly, doesn't fire threshold events
+	UFUNCTION(BlueprintCallable, Category = "Attribute")
+		void SetValue(float Value);
+
+	/// Change per second, negative drains
+	UFUNCTION(BlueprintCallable, Category = "Attribute")
+		void SetRate(float NewRate);
+
+	UFUNCTION(BlueprintCallable, Category = "Attribute")
+		void SetRange(float NewMin, float NewMax);
+
+	/// true while the rate still moves the value, false once it's pinned at a bound
+	UFUNCTION(BlueprintPure, Category = "Attribute")
+		bool IsChanging() const;
+
+protected:
+
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+private:
+
+	float GetTime() const;
+
+	/// fold the elapsed change into BaseValue so Rate can change
+	void Rebase();
+
+	void ScheduleNextThreshold();
+
+	void OnThresholdReached();
+
+	float BaseValue;
+	float BaseTime;
+	float Rate;
+
+	/// value the running timer was set for
+	float PendingThreshold;
+
+	FTimerHandle ThresholdTimer;
+};
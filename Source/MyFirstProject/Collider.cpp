@@ -1,118 +1,121 @@
-// Fill out your copyright notice in the Description page of Project Settings.
-
-#include "Collider.h"
-#include "Components/SphereComponent.h"
-#include "Components/StaticMeshComponent.h"
-#include "UObject/ConstructorHelpers.h"
-#include "Components/InputComponent.h"
-#include "Camera/CameraComponent.h"
-#include "GameFramework/SpringArmComponent.h"
-#include "ColliderMovementComponent.h"
-
-// Sets default values
-ACollider::ACollider()
-{
-	// Set this pawn to call Tick() every frame.  You can turn this off to improve performance if you don't need it.
-	PrimaryActorTick.bCanEverTick = true;
-
-	//RootComponent = CreateDefaultSubobject<USceneComponent>(TEXT("RootComponent"));
-
-	SphereComponent = CreateDefaultSubobject<USphereComponent>(TEXT("SphereComponent"));
-	SphereComponent->InitSphereRadius(40.f);
-	SphereComponent->SetCollisionProfileName(TEXT("Pawn"));
-
-	SetRootComponent(SphereComponent);
-
-	MeshComponent = CreateDefaultSubobject<UStaticMeshComponent>(TEXT("MeshComponent"));
-	MeshComponent->SetupAttachment(GetRootComponent());
-
-	static ConstructorHelpers::FObjectFinder<UStaticMesh> MeshComponentAsset(TEXT("StaticMesh'/Game/StarterContent/Shapes/Shape_Sphere.Shape_Sphere'"));
-
-	if (MeshComponentAsset.Succeeded()) {
-		MeshComponent->SetStaticMesh(MeshComponentAsset.Object);
-		MeshComponent->SetRelativeLocation(FVector(0.f, 0.f, -40.f));
-		MeshComponent->SetWorldScale3D(FVector(0.8f));
-	}
-
-	SpringArm = CreateDefaultSubobject<USpringArmComponent>(TEXT("SpringArm"));
-	SpringArm->SetupAttachment(GetRootComponent());
-	SpringArm->SetRelativeRotation(FRotator(-45.f, 0.f, 0.f));
-	SpringArm->TargetArmLength = 400.f;
-	SpringArm->bEnableCameraLag = true;
-	SpringArm->CameraLagSpeed = 3.0f;
-
-	Camera = CreateDefaultSubobject<UCameraComponent>(TEXT("Camera"));
-	Camera->SetupAttachment(SpringArm, USpringArmComponent::SocketName);
-
-	OurMovementComponent = CreateDefaultSubobject<UColliderMovementComponent>(TEXT("OurMovementComponent"));
-	OurMovementComponent->UpdatedComponent = SphereComponent;
-
-	CameraInput = FVector2D(0.f, 0.f);
-
-	AutoPossessPlayer = EAutoReceiveInput::Player0;
-}
-
-// Called when the game starts or when spawned
-void ACollider::BeginPlay()
-{
-	Super::BeginPlay();
-}
-
-// Called every frame
-void ACollider::Tick(float DeltaTime)
-{
-	Super::Tick(DeltaTime);
-
-	FRotator NewRotation = GetActorRotation();
-	NewRotation.Yaw += CameraInput.X;
-	NewRotation.Pitch += CameraInput.Y;
-
-	SetActorRotation(NewRotation);
-
-	FRotator NewSpringArcmRotation = SpringArm->GetComponentRotation();
-	NewSpringArcmRotation.Pitch = FMath::Clamp(NewSpringArcmRotation.Pitch += CameraInput.Y,-80.f,-15.f);
-
-	SpringArm->SetWorldRotation(NewSpringArcmRotation);
-}
-
-// Called to bind functionality to input
-void ACollider::SetupPlayerInputComponent(UInputComponent* PlayerInputComponent)
-{
-	Super::SetupPlayerInputComponent(PlayerInputComponent);
-
-	PlayerInputComponent->BindAxis(TEXT("MoveForward"), this, &ACollider::MoveForward);
-	PlayerInputComponent->BindAxis(TEXT("MoveRight"), this, &ACollider::MoveRight);
-
-	PlayerInputComponent->BindAxis(TEXT("CameraPitch"), this, &ACollider::PitchCamera);
-	PlayerInputComponent->BindAxis(TEXT("CameraYaw"), this, &ACollider::YawCamera);
-}
-
-void ACollider::MoveForward(float input) {
-	FVector Forward = GetActorForwardVector();
-
-	if (OurMovementComponent)
-	{
-		OurMovementComponent->AddInputVector(input * Forward);
-	}
-};
-
-void ACollider::MoveRight(float input) {
-	FVector Right = GetActorRightVector();
-
-	if (OurMovementComponent)
-	{
-		OurMovementComponent->AddInputVector(input * Right);
-	}
-};
-
-void ACollider::YawCamera(float axisValue) {
-	CameraInput.X = axisValue;
-}
-
-void ACollider::PitchCamera(float axisValue) {
-	CameraInput.Y = axisValue;
-}
-
-UPawnMovementComponent* ACollider::GetMovementComponent() const {
-	return OurMovementComponent;
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Collider.h"
+#include "Components/SphereComponent.h"
+#include "Components/StaticMeshComponent.h"
+#include "UObject/ConstructorHelpers.h"
+#include "Components/InputComponent.h"
+#include "Camera/CameraComponent.h"
+#include "GameFramework/SpringArmComponent.h"
+#include "ColliderMovementComponent.h"
+#include "TickGovernanceSubsystem.h"
+
+// Sets default values
+ACollider::ACollider()
+{
+	// Set this pawn to call Tick() every frame.  You can turn this off to improve performance if you don't need it.
+	PrimaryActorTick.bCanEverTick = true;
+
+	//RootComponent = CreateDefaultSubobject<USceneComponent>(TEXT("RootComponent"));
+
+	SphereComponent = CreateDefaultSubobject<USphereComponent>(TEXT("SphereComponent"));
+	SphereComponent->InitSphereRadius(40.f);
+	SphereComponent->SetCollisionProfileName(TEXT("Pawn"));
+
+	SetRootComponent(SphereComponent);
+
+	MeshComponent = CreateDefaultSubobject<UStaticMeshComponent>(TEXT("MeshComponent"));
+	MeshComponent->SetupAttachment(GetRootComponent());
+
+	static ConstructorHelpers::FObjectFinder<UStaticMesh> MeshComponentAsset(TEXT("StaticMesh'/Game/StarterContent/Shapes/Shape_Sphere.Shape_Sphere'"));
+
+	if (MeshComponentAsset.Succeeded()) {
+		MeshComponent->SetStaticMesh(MeshComponentAsset.Object);
+		MeshComponent->SetRelativeLocation(FVector(0.f, 0.f, -40.f));
+		MeshComponent->SetWorldScale3D(FVector(0.8f));
+	}
+
+	SpringArm = CreateDefaultSubobject<USpringArmComponent>(TEXT("SpringArm"));
+	SpringArm->SetupAttachment(GetRootComponent());
+	SpringArm->SetRelativeRotation(FRotator(-45.f, 0.f, 0.f));
+	SpringArm->TargetArmLength = 400.f;
+	SpringArm->bEnableCameraLag = true;
+	SpringArm->CameraLagSpeed = 3.0f;
+
+	Camera = CreateDefaultSubobject<UCameraComponent>(TEXT("Camera"));
+	Camera->SetupAttachment(SpringArm, USpringArmComponent::SocketName);
+
+	OurMovementComponent = CreateDefaultSubobject<UColliderMovementComponent>(TEXT("OurMovementComponent"));
+	OurMovementComponent->UpdatedComponent = SphereComponent;
+
+	CameraInput = FVector2D(0.f, 0.f);
+
+	AutoPossessPlayer = EAutoReceiveInput::Player0;
+}
+
+// Called when the game starts or when spawned
+void ACollider::BeginPlay()
+{
+	Super::BeginPlay();
+}
+
+// Called every frame
+void ACollider::Tick(float DeltaTime)
+{
+	FTickCostScope TickCost(this);
+
+	Super::Tick(DeltaTime);
+
+	FRotator NewRotation = GetActorRotation();
+	NewRotation.Yaw += CameraInput.X;
+	NewRotation.Pitch += CameraInput.Y;
+
+	SetActorRotation(NewRotation);
+
+	FRotator NewSpringArcmRotation = SpringArm->GetComponentRotation();
+	NewSpringArcmRotation.Pitch = FMath::Clamp(NewSpringArcmRotation.Pitch += CameraInput.Y,-80.f,-15.f);
+
+	SpringArm->SetWorldRotation(NewSpringArcmRotation);
+}
+
+// Called to bind functionality to input
+void ACollider::SetupPlayerInputComponent(UInputComponent* PlayerInputComponent)
+{
+	Super::SetupPlayerInputComponent(PlayerInputComponent);
+
+	PlayerInputComponent->BindAxis(TEXT("MoveForward"), this, &ACollider::MoveForward);
+	PlayerInputComponent->BindAxis(TEXT("MoveRight"), this, &ACollider::MoveRight);
+
+	PlayerInputComponent->BindAxis(TEXT("CameraPitch"), this, &ACollider::PitchCamera);
+	PlayerInputComponent->BindAxis(TEXT("CameraYaw"), this, &ACollider::YawCamera);
+}
+
+void ACollider::MoveForward(float input) {
+	FVector Forward = GetActorForwardVector();
+
+	if (OurMovementComponent)
+	{
+		OurMovementComponent->AddInputVector(input * Forward);
+	}
+};
+
+void ACollider::MoveRight(float input) {
+	FVector Right = GetActorRightVector();
+
+	if (OurMovementComponent)
+	{
+		OurMovementComponent->AddInputVector(input * Right);
+	}
+};
+
+void ACollider::YawCamera(float axisValue) {
+	CameraInput.X = axisValue;
+}
+
+void ACollider::PitchCamera(float axisValue) {
+	CameraInput.Y = axisValue;
+}
+
+UPawnMovementComponent* ACollider::GetMovementComponent() const {
+	return OurMovementComponent;
 }
\ No newline at end of file
@@ -1,28 +1,28 @@
-// Fill out your copyright notice in the Description page of Project Settings.
-
-#include "ColliderMovementComponent.h"
-
-void UColliderMovementComponent::TickComponent(float DeltaTime, enum ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
-{
-	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
-
-	if (!PawnOwner || !UpdatedComponent || ShouldSkipUpdate(DeltaTime)) {
-		return;
-	}
-
-	FVector DesiredMovementThisFrame = ConsumeInputVector().GetClampedToMaxSize(1.0f);
-
-	if (!DesiredMovementThisFrame.IsNearlyZero()) {
-
-		FHitResult Hit;
-
-		SafeMoveUpdatedComponent(DesiredMovementThisFrame, UpdatedComponent->GetComponentRotation(), true, Hit);
-
-		// If We bump into soemething, slide along the side of it
-
-		if (Hit.IsValidBlockingHit()) {
-			SlideAlongSurface(DesiredMovementThisFrame, 1.f - Hit.Time, Hit.Normal, Hit);
-			UE_LOG(LogTemp, Warning, TEXT("Sliding..."));
-		}
-	}
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "ColliderMovementComponent.h"
+
+void UColliderMovementComponent::TickComponent(float DeltaTime, enum ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+	if (!PawnOwner || !UpdatedComponent || ShouldSkipUpdate(DeltaTime)) {
+		return;
+	}
+
+	FVector DesiredMovementThisFrame = ConsumeInputVector().GetClampedToMaxSize(1.0f);
+
+	if (!DesiredMovementThisFrame.IsNearlyZero()) {
+
+		FHitResult Hit;
+
+		SafeMoveUpdatedComponent(DesiredMovementThisFrame, UpdatedComponent->GetComponentRotation(), true, Hit);
+
+		// If We bump into soemething, slide along the side of it
+
+		if (Hit.IsValidBlockingHit()) {
+			SlideAlongSurface(DesiredMovementThisFrame, 1.f - Hit.Time, Hit.Normal, Hit);
+			UE_LOG(LogTemp, Warning, TEXT("Sliding..."));
+		}
+	}
 }
\ No newline at end of file
@@ -1,22 +1,22 @@
-// Fill out your copyright notice in the Description page of Project Settings.
-
-#pragma once
-
-#include "CoreMinimal.h"
-#include "GameFramework/PawnMovementComponent.h"
-#include "ColliderMovementComponent.generated.h"
-
-/**
- * 
- */
-UCLASS()
-class MYFIRSTPROJECT_API UColliderMovementComponent : public UPawnMovementComponent
-{
-	GENERATED_BODY()
-
-public:
-
-	virtual void TickComponent(float DeltaTime, enum ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
-
-	
-};
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/PawnMovementComponent.h"
+#include "ColliderMovementComponent.generated.h"
+
+/**
+ * 
+ */
+UCLASS()
+class MYFIRSTPROJECT_API UColliderMovementComponent : public UPawnMovementComponent
+{
+	GENERATED_BODY()
+
+public:
+
+	virtual void TickComponent(float DeltaTime, enum ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+
+	
+};
@@ -0,0 +1,355 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "CombatBenchmarkSubsystem.h"
+#include "CoreGlobals.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "HAL/PlatformMemory.h"
+#include "Misc/App.h"
+#include "Misc/CommandLine.h"
+#include "Misc/DateTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Kismet/GameplayStatics.h"
+#include "TimerManager.h"
+#include "Enemy.h"
+#include "EnemyPoolSubsystem.h"
+#include "Main.h"
+#include "SpawnVolume.h"
+
+static FAutoConsoleCommandWithWorldAndArgs CombatBenchmarkCommand(
+	TEXT("Bench.Combat"),
+	TEXT("Run the combat scaling benchmark, optional enemy counts e.g. Bench.Combat 10 100 500"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+{
+	if (World)
+	{
+		if (UCombatBenchmarkSubsystem* Benchmark = World->GetSubsystem<UCombatBenchmarkSubsystem>())
+		{
+			TArray<int32> Counts;
+			for (const FString& Arg : Args)
+			{
+				Counts.Add(FCString::Atoi(*Arg));
+			}
+			Benchmark->StartBenchmark(Counts);
+		}
+	}
+}));
+
+namespace
+{
+	/// nearest-rank percentile, Values gets sorted
+	float Percentile(TArray<float>& Values, float P)
+	{
+		if (Values.Num() == 0) return 0.f;
+
+		Values.Sort();
+		const int32 Index = FMath::Clamp(FMath::CeilToInt(P * Values.Num()) - 1, 0, Values.Num() - 1);
+		return Values[Index];
+	}
+
+	float Average(const TArray<float>& Values)
+	{
+		if (Values.Num() == 0) return 0.f;
+
+		float Sum = 0.f;
+		for (float Value : Values)
+		{
+			Sum += Value;
+		}
+		return Sum / Values.Num();
+	}
+}
+
+UCombatBenchmarkSubsystem::UCombatBenchmarkSubsystem()
+{
+	WarmupSeconds = 2.f;
+	MeasureSeconds = 10.f;
+	AttackInterval = 1.f;
+	FrameBudgetMs = 33.3f;
+
+	SpawnVolume = nullptr;
+	Player = nullptr;
+	CountIndex = 0;
+	Phase = EPhase::Idle;
+	PhaseTime = 0.f;
+	AttackTime = 0.f;
+	OrbitAngle = 0.f;
+	bExitWhenDone = false;
+	LastTickTime = 0.0;
+}
+
+void UCombatBenchmarkSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	/// also used when the automation test starts the run
+	FParse::Value(FCommandLine::Get(), TEXT("CombatBenchmarkSeconds="), MeasureSeconds);
+	FParse::Value(FCommandLine::Get(), TEXT("CombatBenchmarkBudgetMs="), FrameBudgetMs);
+
+	if (!InWorld.IsGameWorld() || !FParse::Param(FCommandLine::Get(), TEXT("CombatBenchmark"))) return;
+
+	TArray<int32> CommandLineCounts;
+	FString CountsString;
+	if (FParse::Value(FCommandLine::Get(), TEXT("CombatBenchmarkCounts="), CountsString))
+	{
+		TArray<FString> Parts;
+		CountsString.ParseIntoArray(Parts, TEXT(","));
+		for (const FString& Part : Parts)
+		{
+			CommandLineCounts.Add(FCString::Atoi(*Part));
+		}
+	}
+
+	/// world subsystems begin play before the actors, wait a tick so the spawn volumes and the player are set up
+	InWorld.GetTimerManager().SetTimerForNextTick(FTimerDelegate::CreateUObject(this, &UCombatBenchmarkSubsystem::StartBenchmark, CommandLineCounts, true));
+}
+
+bool UCombatBenchmarkSubsystem::IsTickable() const
+{
+	return IsRunning() && Super::IsTickable();
+}
+
+void UCombatBenchmarkSubsystem::StartBenchmark(const TArray<int32>& EnemyCounts, bool bInExitWhenDone)
+{
+	if (IsRunning()) return;
+
+	UWorld* World = GetWorld();
+	bExitWhenDone = bInExitWhenDone;
+
+	SpawnVolume = nullptr;
+	for (TActorIterator<ASpawnVolume> It(World); It; ++It)
+	{
+		SpawnVolume = *It;
+		break;
+	}
+
+	Player = Cast<AMain>(UGameplayStatics::GetPlayerCharacter(World, 0));
+
+	if (!SpawnVolume || !Player)
+	{
+		UE_LOG(LogTemp, Error, TEXT("CombatBenchmark: the map needs an ASpawnVolume and an AMain player"));
+		Finish();
+		return;
+	}
+
+	Counts = EnemyCounts;
+	Counts.RemoveAll([](int32 Count) { return Count <= 0; });
+	if (Counts.Num() == 0)
+	{
+		Counts = { 10, 100, 500, 1000 };
+	}
+
+	CountIndex = 0;
+	Results.Reset();
+
+	BeginCount();
+}
+
+void UCombatBenchmarkSubsystem::BeginCount()
+{
+	UWorld* World = GetWorld();
+	UEnemyPoolSubsystem* Pool = World->GetSubsystem<UEnemyPoolSubsystem>();
+
+	/// only an AEnemy class of the volume is useful here
+	UClass* EnemyClass = nullptr;
+	for (const TSubclassOf<AActor>& Spawnable : SpawnVolume->SpawnArray)
+	{
+		if (Spawnable && Spawnable->IsChildOf(AEnemy::StaticClass()))
+		{
+			EnemyClass = Spawnable;
+			break;
+		}
+	}
+
+	if (!EnemyClass)
+	{
+		UE_LOG(LogTemp, Error, TEXT("CombatBenchmark: %s has no enemy class to spawn"), *SpawnVolume->GetName());
+		Finish();
+		return;
+	}
+
+	/// enemies already active before spawning, pooled ones are hidden
+	TSet<AEnemy*> Existing;
+	for (TActorIterator<AEnemy> It(World); It; ++It)
+	{
+		if (!It->IsHidden())
+		{
+			Existing.Add(*It);
+		}
+	}
+
+	Current = FCombatBenchmarkResult();
+	Current.Enemies = Counts[CountIndex];
+
+	const FEnemyPoolStats PoolBefore = Pool ? Pool->GetStats() : FEnemyPoolStats();
+	const double SpawnStart = FPlatformTime::Seconds();
+
+	for (int32 i = 0; i < Current.Enemies; i++)
+	{
+		SpawnVolume->SpawnOurActor(EnemyClass, SpawnVolume->GetSpawnPoint());
+	}
+
+	Current.SpawnMs = (FPlatformTime::Seconds() - SpawnStart) * 1000.0;
+
+	if (Pool)
+	{
+		const FEnemyPoolStats PoolAfter = Pool->GetStats();
+		Current.PoolHits = PoolAfter.Hits - PoolBefore.Hits;
+		Current.PoolMisses = PoolAfter.Misses - PoolBefore.Misses;
+	}
+
+	SpawnedEnemies.Reset();
+	for (TActorIterator<AEnemy> It(World); It; ++It)
+	{
+		if (!It->IsHidden() && !Existing.Contains(*It))
+		{
+			SpawnedEnemies.Add(*It);
+		}
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("CombatBenchmark: spawned %d enemies in %.2fms"), Current.Enemies, Current.SpawnMs);
+
+	FrameMs.Reset();
+	GameThreadMs.Reset();
+	Phase = EPhase::Warmup;
+	PhaseTime = 0.f;
+	AttackTime = 0.f;
+	LastTickTime = FPlatformTime::Seconds();
+}
+
+void UCombatBenchmarkSubsystem::Tick(float DeltaTime)
+{
+	if (!Player || !SpawnVolume)
+	{
+		Finish();
+		return;
+	}
+
+	const double Now = FPlatformTime::Seconds();
+	const float WallDelta = Now - LastTickTime;
+	LastTickTime = Now;
+
+	DrivePlayer(DeltaTime);
+
+	PhaseTime += WallDelta;
+
+	if (Phase == EPhase::Warmup)
+	{
+		if (PhaseTime >= WarmupSeconds)
+		{
+			Phase = EPhase::Measure;
+			PhaseTime = 0.f;
+		}
+		return;
+	}
+
+	FrameMs.Add(WallDelta * 1000.f);
+	GameThreadMs.Add(FPlatformTime::ToMilliseconds(GGameThreadTime));
+
+	if (PhaseTime >= MeasureSeconds)
+	{
+		EndCount();
+	}
+}
+
+void UCombatBenchmarkSubsystem::DrivePlayer(float DeltaTime)
+{
+	/// the loop has to run the full duration, the player can't die
+	Player->IncrementHealth(Player->MaxHealth);
+
+	const FVector Center = SpawnVolume->GetActorLocation();
+	const float OrbitRadius = 600.f;
+
+	OrbitAngle += DeltaTime * 0.5f;
+	const FVector Target = Center + FVector(FMath::Cos(OrbitAngle), FMath::Sin(OrbitAngle), 0.f) * OrbitRadius;
+
+	FVector Direction = Target - Player->GetActorLocation();
+	Direction.Z = 0.f;
+	Player->AddMovementInput(Direction.GetSafeNormal(), 1.f);
+
+	AttackTime += DeltaTime;
+	if (AttackTime >= AttackInterval)
+	{
+		AttackTime = 0.f;
+
+		Player->UpdateCombatTarget();
+		if (Player->EquippedWeapon)
+		{
+			Player->Attack();
+		}
+	}
+}
+
+void UCombatBenchmarkSubsystem::EndCount()
+{
+	Current.Frames = FrameMs.Num();
+	Current.AvgFrameMs = Average(FrameMs);
+	Current.AvgGameThreadMs = Average(GameThreadMs);
+	Current.P50FrameMs = Percentile(FrameMs, 0.5f);
+	Current.P95FrameMs = Percentile(FrameMs, 0.95f);
+	Current.P99FrameMs = Percentile(FrameMs, 0.99f);
+	Current.P95GameThreadMs = Percentile(GameThreadMs, 0.95f);
+
+	const FPlatformMemoryStats Memory = FPlatformMemory::GetStats();
+	Current.UsedPhysicalMB = Memory.UsedPhysical / (1024.f * 1024.f);
+	Current.PeakUsedPhysicalMB = Memory.PeakUsedPhysical / (1024.f * 1024.f);
+
+	UE_LOG(LogTemp, Log, TEXT("CombatBenchmark: %d enemies, frame avg %.2fms p95 %.2fms p99 %.2fms, game thread avg %.2fms, %.0fMB used"),
+		Current.Enemies, Current.AvgFrameMs, Current.P95FrameMs, Current.P99FrameMs, Current.AvgGameThreadMs, Current.UsedPhysicalMB);
+
+	Results.Add(Current);
+
+	for (AEnemy* Enemy : SpawnedEnemies)
+	{
+		if (IsValid(Enemy) && !Enemy->IsHidden()) /// enemies killed by the player are already back in the pool
+		{
+			Enemy->Disappear();
+		}
+	}
+	SpawnedEnemies.Reset();
+
+	if (++CountIndex < Counts.Num())
+	{
+		BeginCount();
+	} else
+	{
+		WriteCSV();
+		Finish();
+	}
+}
+
+void UCombatBenchmarkSubsystem::Finish()
+{
+	Phase = EPhase::Idle;
+	SpawnedEnemies.Reset();
+
+	if (bExitWhenDone)
+	{
+		FPlatformMisc::RequestExit(false);
+	}
+}
+
+bool UCombatBenchmarkSubsystem::WriteCSV() const
+{
+	FString CSV = TEXT("Build,Enemies,SpawnMs,SpawnMsPerEnemy,PoolHits,PoolMisses,Frames,AvgFrameMs,P50FrameMs,P95FrameMs,P99FrameMs,AvgGameThreadMs,P95GameThreadMs,UsedPhysicalMB,PeakUsedPhysicalMB\n");
+
+	for (const FCombatBenchmarkResult& Result : Results)
+	{
+		CSV += FString::Printf(TEXT("%s,%d,%.3f,%.4f,%d,%d,%d,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f,%.1f,%.1f\n"),
+			FApp::GetBuildVersion(), Result.Enemies, Result.SpawnMs, Result.SpawnMs / FMath::Max(Result.Enemies, 1), Result.PoolHits, Result.PoolMisses,
+			Result.Frames, Result.AvgFrameMs, Result.P50FrameMs, Result.P95FrameMs, Result.P99FrameMs, Result.AvgGameThreadMs, Result.P95GameThreadMs,
+			Result.UsedPhysicalMB, Result.PeakUsedPhysicalMB);
+	}
+
+	const FString FileName = FPaths::ProjectSavedDir() / TEXT("Benchmarks") / FString::Printf(TEXT("CombatBenchmark_%s.csv"), *FDateTime::Now().ToString());
+
+	if (!FFileHelper::SaveStringToFile(CSV, *FileName))
+	{
+		UE_LOG(LogTemp, Error, TEXT("CombatBenchmark: couldn't write %s"), *FileName);
+		return false;
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("CombatBenchmark: results written to %s"), *FileName);
+	return true;
+}
\ No newline at end of file
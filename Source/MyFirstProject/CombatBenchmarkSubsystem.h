@@ -0,0 +1,116 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "TickableGameplaySubsystem.h"
+#include "CombatBenchmarkSubsystem.generated.h"
+
+/// One row of the benchmark CSV, everything measured for one enemy count
+struct FCombatBenchmarkResult
+{
+	int32 Enemies = 0;
+	float SpawnMs = 0.f;
+	int32 PoolHits = 0;
+	int32 PoolMisses = 0;
+	int32 Frames = 0;
+	float AvgFrameMs = 0.f;
+	float P50FrameMs = 0.f;
+	float P95FrameMs = 0.f;
+	float P99FrameMs = 0.f;
+	float AvgGameThreadMs = 0.f;
+	float P95GameThreadMs = 0.f;
+	float UsedPhysicalMB = 0.f;
+	float PeakUsedPhysicalMB = 0.f;
+};
+
+/**
+ * Repeatable combat scaling benchmark: spawns increasing enemy counts through the level's ASpawnVolume,
+ * drives the player through a scripted fight and writes frame timings, spawn cost and memory to Saved/Benchmarks
+ * Run headless with -game -nullrhi -CombatBenchmark [-CombatBenchmarkCounts=10,100] [-CombatBenchmarkSeconds=10], the process exits when done,
+ * or as the MyFirstProject.Performance.CombatBenchmark automation test which checks the results against FrameBudgetMs
+ */
+UCLASS()
+class MYFIRSTPROJECT_API UCombatBenchmarkSubsystem: public UTickableGameplaySubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	UCombatBenchmarkSubsystem();
+
+	/// Seconds of play after spawning before frames are recorded
+	float WarmupSeconds;
+
+	/// Seconds of frames recorded for each enemy count
+	float MeasureSeconds;
+
+	/// Seconds between scripted player attacks
+	float AttackInterval;
+
+	/// 95th percentile frame time every enemy count has to stay under for the automation test to pass
+	float FrameBudgetMs;
+
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+
+	virtual void Tick(float DeltaTime) override;
+
+	virtual bool IsTickable() const override;
+
+	/// Run the benchmark for each enemy count in order, does nothing if one is already running
+	void StartBenchmark(const TArray<int32>& EnemyCounts, bool bExitWhenDone = false);
+
+	bool IsRunning() const { return Phase != EPhase::Idle; }
+
+	/// One entry per enemy count of the last run
+	const TArray<FCombatBenchmarkResult>& GetResults() const { return Results; }
+
+private:
+
+	enum class EPhase: uint8
+	{
+		Idle,
+		Warmup,
+		Measure
+	};
+
+	/// spawn the enemies of the current count through the spawn volume
+	void BeginCount();
+
+	/// record the current count and return its enemies to the pool
+	void EndCount();
+
+	/// scripted combat loop: circle the spawn volume and attack on a timer
+	void DrivePlayer(float DeltaTime);
+
+	void Finish();
+
+	bool WriteCSV() const;
+
+	UPROPERTY()
+		class ASpawnVolume* SpawnVolume;
+
+	UPROPERTY()
+		class AMain* Player;
+
+	UPROPERTY()
+		TArray<class AEnemy*> SpawnedEnemies;
+
+	TArray<int32> Counts;
+	int32 CountIndex;
+
+	EPhase Phase;
+	float PhaseTime;
+	float AttackTime;
+	float OrbitAngle;
+	bool bExitWhenDone;
+
+	/// wall clock of the previous tick, frame time doesn't trust DeltaTime so -benchmark fixed steps still measure real cost
+	double LastTickTime;
+
+	TArray<float> FrameMs;
+	TArray<float> GameThreadMs;
+
+	FCombatBenchmarkResult Current;
+	TArray<FCombatBenchmarkResult> Results;
+};
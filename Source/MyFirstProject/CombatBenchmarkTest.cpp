@@ -0,0 +1,115 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "CombatBenchmarkSubsystem.h"
+#include "AssetRegistryModule.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "Misc/AutomationTest.h"
+#include "Tests/AutomationCommon.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace CombatBenchmarkTest
+{
+	/// the world the automation opened the map in, PIE in the editor, the game world with -game
+	UWorld* GetTestWorld()
+	{
+		for (const FWorldContext& Context : GEngine->GetWorldContexts())
+		{
+			if ((Context.WorldType == EWorldType::PIE || Context.WorldType == EWorldType::Game) && Context.World())
+			{
+				return Context.World();
+			}
+		}
+		return nullptr;
+	}
+}
+
+/// Start the benchmark with the default enemy counts once the map has begun play
+DEFINE_LATENT_AUTOMATION_COMMAND_ONE_PARAMETER(FStartCombatBenchmarkCommand, FAutomationTestBase*, Test);
+
+bool FStartCombatBenchmarkCommand::Update()
+{
+	UWorld* World = CombatBenchmarkTest::GetTestWorld();
+	if (!World || !World->HasBegunPlay()) return false; /// try again next frame
+
+	UCombatBenchmarkSubsystem* Benchmark = World->GetSubsystem<UCombatBenchmarkSubsystem>();
+	if (!Benchmark)
+	{
+		Test->AddError(TEXT("No combat benchmark subsystem in the test world"));
+		return true;
+	}
+
+	Benchmark->StartBenchmark(TArray<int32>());
+	return true;
+}
+
+/// Wait for the run to end and check every enemy count against the frame budget
+DEFINE_LATENT_AUTOMATION_COMMAND_ONE_PARAMETER(FCheckCombatBenchmarkCommand, FAutomationTestBase*, Test);
+
+bool FCheckCombatBenchmarkCommand::Update()
+{
+	UWorld* World = CombatBenchmarkTest::GetTestWorld();
+	UCombatBenchmarkSubsystem* Benchmark = World ? World->GetSubsystem<UCombatBenchmarkSubsystem>() : nullptr;
+
+	if (!Benchmark)
+	{
+		Test->AddError(TEXT("The test world went away before the combat benchmark finished"));
+		return true;
+	}
+
+	if (Benchmark->IsRunning()) return false;
+
+	if (Benchmark->GetResults().Num() == 0)
+	{
+		Test->AddError(TEXT("The combat benchmark measured nothing, the map needs an ASpawnVolume with an enemy class and an AMain player"));
+		return true;
+	}
+
+	for (const FCombatBenchmarkResult& Result : Benchmark->GetResults())
+	{
+		const FString Summary = FString::Printf(TEXT("%d enemies: frame p95 %.2fms (budget %.2fms), game thread avg %.2fms, spawn %.2fms"),
+			Result.Enemies, Result.P95FrameMs, Benchmark->FrameBudgetMs, Result.AvgGameThreadMs, Result.SpawnMs);
+
+		if (Result.P95FrameMs > Benchmark->FrameBudgetMs)
+		{
+			Test->AddError(Summary);
+		} else
+		{
+			Test->AddInfo(Summary);
+		}
+	}
+	return true;
+}
+
+/// One case per project map, run headless with -game -nullrhi -ExecCmds="Automation RunTests MyFirstProject.Performance.CombatBenchmark; Quit"
+IMPLEMENT_COMPLEX_AUTOMATION_TEST(FCombatBenchmarkTest, "MyFirstProject.Performance.CombatBenchmark", EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter)
+
+void FCombatBenchmarkTest::GetTests(TArray<FString>& OutBeautifiedNames, TArray<FString>& OutTestCommands) const
+{
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+
+	TArray<FAssetData> Maps;
+	AssetRegistry.GetAssetsByPath(TEXT("/Game/Maps"), Maps, true);
+
+	for (const FAssetData& Map : Maps)
+	{
+		if (Map.AssetClass == UWorld::StaticClass()->GetFName())
+		{
+			OutBeautifiedNames.Add(Map.AssetName.ToString());
+			OutTestCommands.Add(Map.PackageName.ToString());
+		}
+	}
+}
+
+bool FCombatBenchmarkTest::RunTest(const FString& Parameters)
+{
+	AutomationOpenMap(Parameters);
+
+	ADD_LATENT_AUTOMATION_COMMAND(FStartCombatBenchmarkCommand(this));
+	ADD_LATENT_AUTOMATION_COMMAND(FCheckCombatBenchmarkCommand(this));
+
+	return true;
+}
+
+#endif
\ No newline at end of file
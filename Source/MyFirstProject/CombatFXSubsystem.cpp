@@ -0,0 +1,275 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "CombatFXSubsystem.h"
+#include "Engine/World.h"
+#include "GameFramework/WorldSettings.h"
+#include "GameFramework/PlayerController.h"
+#include "Particles/ParticleSystem.h"
+#include "Particles/ParticleSystemComponent.h"
+#include "Components/AudioComponent.h"
+#include "Sound/SoundBase.h"
+
+static FAutoConsoleCommandWithWorld FXStatsCommand(
+	TEXT("FX.Stats"),
+	TEXT("Print combat FX dispatcher counters"),
+	FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+{
+	if (World)
+	{
+		if (UCombatFXSubsystem* FX = World->GetSubsystem<UCombatFXSubsystem>())
+		{
+			FX->LogStats();
+		}
+	}
+}));
+
+UCombatFXSubsystem::UCombatFXSubsystem()
+{
+	MaxParticleComponents = 32;
+	MaxAudioComponents = 16;
+	MaxEmittersPerFrame = 8;
+	MaxSoundsPerFrame = 4;
+	MaxVoicesPerSound = 3;
+	CullDistance = 6000.f;
+	MergeRadius = 50.f;
+
+	CurrentFrame = 0;
+	EmittersThisFrame = 0;
+	SoundsThisFrame = 0;
+}
+
+void UCombatFXSubsystem::Deinitialize()
+{
+	for (UParticleSystemComponent* Component : ParticlePool)
+	{
+		if (Component) Component->DestroyComponent();
+	}
+	for (UAudioComponent* Component : AudioPool)
+	{
+		if (Component) Component->DestroyComponent();
+	}
+	ParticlePool.Empty();
+	AudioPool.Empty();
+	ParticleStartTimes.Empty();
+	AudioStartTimes.Empty();
+
+	Super::Deinitialize();
+}
+
+void UCombatFXSubsystem::PlayHitEffect(UParticleSystem* Particles, USoundBase* Sound, const FVector& Location)
+{
+	if (Particles)
+	{
+		SpawnEmitter(Particles, Location, FRotator(0.f));
+	}
+	if (Sound)
+	{
+		PlaySound2D(Sound, Location);
+	}
+}
+
+bool UCombatFXSubsystem::SpawnEmitter(UParticleSystem* Particles, const FVector& Location, const FRotator& Rotation)
+{
+	if (!Particles) return false;
+
+	BeginFrameIfNeeded();
+
+	const float MergeRadiusSquared = MergeRadius * MergeRadius;
+	for (const TPair<UParticleSystem*, FVector>& Played : FrameEmitters)
+	{
+		if (Played.Key == Particles && FVector::DistSquared(Played.Value, Location) <= MergeRadiusSquared)
+		{
+			Stats.Merged++;
+			return false;
+		}
+	}
+
+	if (EmittersThisFrame >= MaxEmittersPerFrame)
+	{
+		Stats.Capped++;
+		return false;
+	}
+
+	if (IsCulled(Location))
+	{
+		Stats.Culled++;
+		return false;
+	}
+
+	UParticleSystemComponent* Component = AcquireParticleComponent();
+	if (!Component) return false;
+
+	if (Component->Template != Particles)
+	{
+		Component->SetTemplate(Particles);
+	}
+	Component->SetWorldLocationAndRotation(Location, Rotation);
+	Component->ActivateSystem(true);
+
+	FrameEmitters.Add(TPair<UParticleSystem*, FVector>(Particles, Location));
+	EmittersThisFrame++;
+	Stats.EmittersPlayed++;
+
+	return true;
+}
+
+bool UCombatFXSubsystem::PlaySound2D(USoundBase* Sound, const FVector& Location)
+{
+	if (!Sound) return false;
+
+	BeginFrameIfNeeded();
+
+	if (FrameSounds.Contains(Sound)) /// the same sound twice in a frame is heard as one
+	{
+		Stats.Merged++;
+		return false;
+	}
+
+	if (SoundsThisFrame >= MaxSoundsPerFrame)
+	{
+		Stats.Capped++;
+		return false;
+	}
+
+	if (IsCulled(Location))
+	{
+		Stats.Culled++;
+		return false;
+	}
+
+	int32 Voices = 0;
+	for (UAudioComponent* Component : AudioPool)
+	{
+		if (Component && Component->Sound == Sound && Component->IsPlaying()) Voices++;
+	}
+	if (Voices >= MaxVoicesPerSound)
+	{
+		Stats.Capped++;
+		return false;
+	}
+
+	UAudioComponent* Component = AcquireAudioComponent();
+	if (!Component) return false;
+
+	Component->SetSound(Sound);
+	Component->Play();
+
+	FrameSounds.Add(Sound);
+	SoundsThisFrame++;
+	Stats.SoundsPlayed++;
+
+	return true;
+}
+
+void UCombatFXSubsystem::LogStats() const
+{
+	UE_LOG(LogTemp, Log, TEXT("CombatFX: emitters %d, sounds %d, merged %d, capped %d, culled %d, stolen %d, pool %d/%d particles %d/%d audio"),
+		Stats.EmittersPlayed, Stats.SoundsPlayed, Stats.Merged, Stats.Capped, Stats.Culled, Stats.Stolen,
+		ParticlePool.Num(), MaxParticleComponents, AudioPool.Num(), MaxAudioComponents);
+}
+
+void UCombatFXSubsystem::BeginFrameIfNeeded()
+{
+	if (CurrentFrame != GFrameCounter)
+	{
+		CurrentFrame = GFrameCounter;
+		EmittersThisFrame = 0;
+		SoundsThisFrame = 0;
+		FrameEmitters.Reset();
+		FrameSounds.Reset();
+	}
+}
+
+bool UCombatFXSubsystem::IsCulled(const FVector& Location) const
+{
+	APlayerController* PlayerController = GetWorld()->GetFirstPlayerController();
+	if (!PlayerController) return false;
+
+	FVector ViewLocation;
+	FRotator ViewRotation;
+	PlayerController->GetPlayerViewPoint(ViewLocation, ViewRotation);
+
+	return FVector::DistSquared(ViewLocation, Location) > CullDistance * CullDistance;
+}
+
+UParticleSystemComponent* UCombatFXSubsystem::AcquireParticleComponent()
+{
+	UWorld* World = GetWorld();
+	const float Now = World->GetTimeSeconds();
+
+	for (int32 i = 0; i < ParticlePool.Num(); i++)
+	{
+		if (ParticlePool[i] && !ParticlePool[i]->IsActive())
+		{
+			ParticleStartTimes[i] = Now;
+			return ParticlePool[i];
+		}
+	}
+
+	if (ParticlePool.Num() < MaxParticleComponents)
+	{
+		UParticleSystemComponent* Component = NewObject<UParticleSystemComponent>(World->GetWorldSettings());
+		Component->bAutoActivate = false;
+		Component->bAutoDestroy = false; /// the pool owns it
+		Component->RegisterComponentWithWorld(World);
+
+		ParticlePool.Add(Component);
+		ParticleStartTimes.Add(Now);
+		return Component;
+	}
+
+	/// every component is busy, cut off the one playing the longest
+	Stats.Stolen++;
+	int32 Oldest = 0;
+	for (int32 i = 1; i < ParticleStartTimes.Num(); i++)
+	{
+		if (ParticleStartTimes[i] < ParticleStartTimes[Oldest])
+		{
+			Oldest = i;
+		}
+	}
+	ParticleStartTimes[Oldest] = Now;
+	return ParticlePool[Oldest];
+}
+
+UAudioComponent* UCombatFXSubsystem::AcquireAudioComponent()
+{
+	UWorld* World = GetWorld();
+	const float Now = World->GetTimeSeconds();
+
+	for (int32 i = 0; i < AudioPool.Num(); i++)
+	{
+		if (AudioPool[i] && !AudioPool[i]->IsPlaying())
+		{
+			AudioStartTimes[i] = Now;
+			return AudioPool[i];
+		}
+	}
+
+	if (AudioPool.Num() < MaxAudioComponents)
+	{
+		UAudioComponent* Component = NewObject<UAudioComponent>(World->GetWorldSettings());
+		Component->bAutoActivate = false;
+		Component->bAutoDestroy = false; /// the pool owns it
+		Component->bAllowSpatialization = false; /// same as UGameplayStatics::PlaySound2D
+		Component->bIsUISound = false;
+		Component->RegisterComponentWithWorld(World);
+
+		AudioPool.Add(Component);
+		AudioStartTimes.Add(Now);
+		return Component;
+	}
+
+	Stats.Stolen++;
+	int32 Oldest = 0;
+	for (int32 i = 1; i < AudioStartTimes.Num(); i++)
+	{
+		if (AudioStartTimes[i] < AudioStartTimes[Oldest])
+		{
+			Oldest = i;
+		}
+	}
+	AudioStartTimes[Oldest] = Now;
+	AudioPool[Oldest]->Stop();
+	return AudioPool[Oldest];
+}
\ No newline at end of file
@@ -0,0 +1,121 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "CombatFXSubsystem.generated.h"
+
+/// Counters reported by the combat FX dispatcher
+USTRUCT(BlueprintType)
+struct FCombatFXStats
+{
+	GENERATED_BODY()
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "FX")
+		int32 EmittersPlayed = 0;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "FX")
+		int32 SoundsPlayed = 0;
+
+	/// requests merged with an identical one of the same frame
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "FX")
+		int32 Merged = 0;
+
+	/// requests dropped by the per-frame caps or voice limits
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "FX")
+		int32 Capped = 0;
+
+	/// requests dropped for being too far from the player view
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "FX")
+		int32 Culled = 0;
+
+	/// pooled components that were cut off to play a new request
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "FX")
+		int32 Stolen = 0;
+};
+
+/**
+ * Plays hit particles and combat sounds from pooled components with per-frame caps, voice limits and distance culling
+ */
+UCLASS()
+class MYFIRSTPROJECT_API UCombatFXSubsystem: public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	UCombatFXSubsystem();
+
+	/// Size of the particle component pool
+	int32 MaxParticleComponents;
+
+	/// Size of the audio component pool
+	int32 MaxAudioComponents;
+
+	/// Emitters started in a single frame, the rest is dropped
+	int32 MaxEmittersPerFrame;
+
+	/// Sounds started in a single frame, the rest is dropped
+	int32 MaxSoundsPerFrame;
+
+	/// Instances of the same sound allowed to play at once
+	int32 MaxVoicesPerSound;
+
+	/// Requests farther than this from the player view are dropped
+	float CullDistance;
+
+	/// Same particle template requested this close in the same frame plays only once
+	float MergeRadius;
+
+	virtual void Deinitialize() override;
+
+	/// Spawn hit particles at Location and play the hit sound, what every melee hit goes through
+	UFUNCTION(BlueprintCallable, Category = "FX")
+		void PlayHitEffect(class UParticleSystem* Particles, class USoundBase* Sound, const FVector& Location);
+
+	/// Spawn a pooled emitter, returns false if the request was merged, capped or culled
+	UFUNCTION(BlueprintCallable, Category = "FX")
+		bool SpawnEmitter(UParticleSystem* Particles, const FVector& Location, const FRotator& Rotation);
+
+	/// Play a pooled 2D sound caused at Location, returns false if the request was merged, capped or culled
+	UFUNCTION(BlueprintCallable, Category = "FX")
+		bool PlaySound2D(USoundBase* Sound, const FVector& Location);
+
+	UFUNCTION(BlueprintPure, Category = "FX")
+		FCombatFXStats GetStats() const { return Stats; }
+
+	void LogStats() const;
+
+private:
+
+	/// reset the per-frame counters when a new frame started
+	void BeginFrameIfNeeded();
+
+	/// distance culling against the first local player's view point
+	bool IsCulled(const FVector& Location) const;
+
+	class UParticleSystemComponent* AcquireParticleComponent();
+
+	class UAudioComponent* AcquireAudioComponent();
+
+	UPROPERTY()
+		TArray<UParticleSystemComponent*> ParticlePool;
+
+	UPROPERTY()
+		TArray<UAudioComponent*> AudioPool;
+
+	/// world time each pooled component was last handed out, the earliest is cut off when the whole pool is busy
+	TArray<float> ParticleStartTimes;
+	TArray<float> AudioStartTimes;
+
+	uint64 CurrentFrame;
+	int32 EmittersThisFrame;
+	int32 SoundsThisFrame;
+
+	/// what already played this frame, for merging duplicate hits
+	TArray<TPair<UParticleSystem*, FVector>, TInlineAllocator<16>> FrameEmitters;
+	TArray<USoundBase*, TInlineAllocator<16>> FrameSounds;
+
+	FCombatFXStats Stats;
+};
@@ -0,0 +1,211 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "CombatTelemetrySubsystem.h"
+#include "Async/Async.h"
+#include "Engine/World.h"
+#include "Engine/GameInstance.h"
+#include "GameFramework/Actor.h"
+#include "HAL/FileManager.h"
+#include "Misc/CommandLine.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include "UObject/UObjectGlobals.h"
+
+namespace CombatTraceFormat
+{
+	/// 'CTRC'
+	constexpr uint32 Magic = 0x43545243;
+	constexpr int32 Version = 1;
+}
+
+static TAutoConsoleVariable<int32> CVarCombatTrace(
+	TEXT("game.CombatTrace"),
+	0,
+	TEXT("1: record hits, deaths, spawns, pickups, level switches and saves to Saved/CombatTraces (also on with -combattrace)"));
+
+FArchive& operator<<(FArchive& Ar, FCombatTraceEvent& Event)
+{
+	uint8 Type = static_cast<uint8>(Event.Type);
+
+	Ar << Type;
+	Ar << Event.Time;
+	Ar << Event.Location;
+	Ar << Event.Subject;
+	Ar << Event.Value;
+
+	Event.Type = static_cast<ECombatTraceEvent>(Type);
+
+	if (Event.Type == ECombatTraceEvent::LevelSwitch)
+	{
+		Ar << Event.Name;
+	}
+	return Ar;
+}
+
+UCombatTelemetrySubsystem::UCombatTelemetrySubsystem()
+{
+	FlushBytes = 64 * 1024;
+
+	LevelTimeBase = 0.f;
+	LastEventTime = 0.f;
+	bHeaderWritten = false;
+}
+
+void UCombatTelemetrySubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	if (FParse::Param(FCommandLine::Get(), TEXT("combattrace")))
+	{
+		CVarCombatTrace->Set(1, ECVF_SetByCommandline);
+	}
+
+	PostLoadMapHandle = FCoreUObjectDelegates::PostLoadMapWithWorld.AddUObject(this, &UCombatTelemetrySubsystem::OnPostLoadMap);
+
+	TracePath = GetTraceDirectory() / FString::Printf(TEXT("Session_%s.ctrace"), *FDateTime::Now().ToString());
+}
+
+void UCombatTelemetrySubsystem::Deinitialize()
+{
+	FCoreUObjectDelegates::PostLoadMapWithWorld.Remove(PostLoadMapHandle);
+
+	Flush();
+
+	if (WriteTask.IsValid())
+	{
+		WriteTask.Wait(); /// the end of the session must reach the file
+	}
+
+	Super::Deinitialize();
+}
+
+bool UCombatTelemetrySubsystem::IsTracing()
+{
+	return CVarCombatTrace.GetValueOnGameThread() != 0;
+}
+
+FString UCombatTelemetrySubsystem::GetTraceDirectory()
+{
+	return FPaths::ProjectSavedDir() / TEXT("CombatTraces");
+}
+
+void UCombatTelemetrySubsystem::Record(const UObject* WorldContextObject, ECombatTraceEvent Type, const FVector& Location, const AActor* Subject, float Value)
+{
+	if (!IsTracing() || !WorldContextObject) return;
+
+	UWorld* World = WorldContextObject->GetWorld();
+	UGameInstance* GameInstance = World ? World->GetGameInstance() : nullptr;
+
+	if (UCombatTelemetrySubsystem* Telemetry = GameInstance ? GameInstance->GetSubsystem<UCombatTelemetrySubsystem>() : nullptr)
+	{
+		FCombatTraceEvent Event;
+		Event.Type = Type;
+		Event.Location = Location;
+		Event.Subject = Subject ? Subject->GetUniqueID() : 0;
+		Event.Value = Value;
+
+		Telemetry->Append(Event, WorldContextObject);
+	}
+}
+
+void UCombatTelemetrySubsystem::RecordLevelSwitch(const UObject* WorldContextObject, FName LevelName, const FVector& Location)
+{
+	if (!IsTracing() || !WorldContextObject) return;
+
+	UWorld* World = WorldContextObject->GetWorld();
+	UGameInstance* GameInstance = World ? World->GetGameInstance() : nullptr;
+
+	if (UCombatTelemetrySubsystem* Telemetry = GameInstance ? GameInstance->GetSubsystem<UCombatTelemetrySubsystem>() : nullptr)
+	{
+		FCombatTraceEvent Event;
+		Event.Type = ECombatTraceEvent::LevelSwitch;
+		Event.Location = Location;
+		Event.Name = LevelName.ToString();
+
+		Telemetry->Append(Event, WorldContextObject);
+		Telemetry->Flush();
+	}
+}
+
+float UCombatTelemetrySubsystem::GetSessionTime(const UObject* WorldContextObject) const
+{
+	const UWorld* World = WorldContextObject->GetWorld();
+
+	return LevelTimeBase + (World ? World->GetTimeSeconds() : 0.f);
+}
+
+void UCombatTelemetrySubsystem::OnPostLoadMap(UWorld* LoadedWorld)
+{
+	LevelTimeBase = LastEventTime;
+}
+
+void UCombatTelemetrySubsystem::Append(FCombatTraceEvent& Event, const UObject* WorldContextObject)
+{
+	Event.Time = GetSessionTime(WorldContextObject);
+	LastEventTime = Event.Time;
+
+	FMemoryWriter Writer(Buffer, false, true); /// append
+
+	if (!bHeaderWritten)
+	{
+		uint32 Magic = CombatTraceFormat::Magic;
+		int32 Version = CombatTraceFormat::Version;
+		Writer << Magic;
+		Writer << Version;
+		bHeaderWritten = true;
+	}
+
+	Writer << Event;
+
+	if (Buffer.Num() >= FlushBytes)
+	{
+		Flush();
+	}
+}
+
+void UCombatTelemetrySubsystem::Flush()
+{
+	if (Buffer.Num() == 0) return;
+
+	if (WriteTask.IsValid())
+	{
+		WriteTask.Wait(); /// keep the chunks in order, a 64KB write is long done by the time the next buffer is full
+	}
+
+	WriteTask = Async(EAsyncExecution::ThreadPool, [Path = TracePath, Data = MoveTemp(Buffer)]()
+	{
+		if (!FFileHelper::SaveArrayToFile(Data, *Path, &IFileManager::Get(), FILEWRITE_Append))
+		{
+			UE_LOG(LogTemp, Warning, TEXT("Could not write the combat trace %s"), *Path);
+		}
+	});
+
+	Buffer.Reset();
+}
+
+bool UCombatTelemetrySubsystem::ReadTrace(const FString& Path, TArray<FCombatTraceEvent>& OutEvents)
+{
+	TArray<uint8> File;
+	if (!FFileHelper::LoadFileToArray(File, *Path)) return false;
+
+	FMemoryReader Reader(File);
+	uint32 Magic = 0;
+	int32 Version = 0;
+	Reader << Magic;
+	Reader << Version;
+
+	if (Magic != CombatTraceFormat::Magic || Version != CombatTraceFormat::Version) return false;
+
+	while (!Reader.AtEnd() && !Reader.IsError())
+	{
+		FCombatTraceEvent Event;
+		Reader << Event;
+
+		if (Reader.IsError() || Event.Type >= ECombatTraceEvent::MAX) break; /// cut short by a crash, keep what was complete
+
+		OutEvents.Add(MoveTemp(Event));
+	}
+	return true;
+}
\ No newline at end of file
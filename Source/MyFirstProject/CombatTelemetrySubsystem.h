@@ -0,0 +1,110 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "Async/Future.h"
+#include "CombatTelemetrySubsystem.generated.h"
+
+/// Kinds of events in a combat trace, stored as uint8 so never reorder them
+enum class ECombatTraceEvent: uint8
+{
+	EnemyHit,		/// damage taken by an enemy, Value is the damage
+	PlayerHit,		/// damage taken by the player, Value is the damage
+	EnemyDeath,
+	PlayerDeath,
+	Spawn,			/// actor spawned by a spawn volume
+	Pickup,
+	LevelSwitch,	/// Name is the level being opened
+	Save,
+
+	MAX
+};
+
+/// One event of a combat trace
+struct FCombatTraceEvent
+{
+	ECombatTraceEvent Type = ECombatTraceEvent::MAX;
+
+	/// game time in seconds since the session started, pauses excluded, continues across level switches
+	float Time = 0.f;
+
+	FVector Location = FVector::ZeroVector;
+
+	/// unique id of the actor the event is about (victim, spawned or dead actor), 0 if none
+	uint32 Subject = 0;
+
+	float Value = 0.f;
+
+	/// only written for LevelSwitch
+	FString Name;
+
+	friend FArchive& operator<<(FArchive& Ar, FCombatTraceEvent& Event);
+};
+
+/**
+ * Records combat events of a play session into Saved/CombatTraces without a profiler attached, turned on with
+ * game.CombatTrace 1 or -combattrace. Events are appended to a memory buffer, full buffers are written to the
+ * trace file on a worker thread. The CombatTrace commandlet turns the traces into per-encounter statistics
+ */
+UCLASS()
+class MYFIRSTPROJECT_API UCombatTelemetrySubsystem: public UGameInstanceSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	UCombatTelemetrySubsystem();
+
+	/// Buffered bytes that trigger a write to the trace file
+	int32 FlushBytes;
+
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+
+	virtual void Deinitialize() override;
+
+	/// Record an event if tracing is on, cheap no-op otherwise
+	static void Record(const UObject* WorldContextObject, ECombatTraceEvent Type, const FVector& Location, const AActor* Subject = nullptr, float Value = 0.f);
+
+	/// Record a level switch and write what is buffered, the next level continues the same trace
+	static void RecordLevelSwitch(const UObject* WorldContextObject, FName LevelName, const FVector& Location);
+
+	static bool IsTracing();
+
+	/// Write the buffered events on a worker
+	void Flush();
+
+	/// Read every event of a trace file, false if it isn't one
+	static bool ReadTrace(const FString& Path, TArray<FCombatTraceEvent>& OutEvents);
+
+	/// Folder the traces are written to
+	static FString GetTraceDirectory();
+
+private:
+
+	void Append(FCombatTraceEvent& Event, const UObject* WorldContextObject);
+
+	/// game time of the events, the world time of the current level on top of the levels before
+	float GetSessionTime(const UObject* WorldContextObject) const;
+
+	/// the new level's world time starts over from 0, continue from the last event so load time doesn't count
+	void OnPostLoadMap(UWorld* LoadedWorld);
+
+	FString TracePath;
+
+	/// serialized events not written yet
+	TArray<uint8> Buffer;
+
+	/// game time the previous levels of the session lasted
+	float LevelTimeBase;
+
+	/// time of the newest event, the old level keeps running while the next one loads
+	float LastEventTime;
+
+	bool bHeaderWritten;
+
+	TFuture<void> WriteTask;
+
+	FDelegateHandle PostLoadMapHandle;
+};
@@ -0,0 +1,274 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "CombatTraceCommandlet.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "CombatTelemetrySubsystem.h"
+
+/// Everything one encounter of a trace adds up to
+struct FCombatEncounter
+{
+	FString File;
+	FString Level;
+	int32 Index = 0;
+
+	float Start = 0.f;
+	float End = 0.f;
+
+	float EnemyDamage = 0.f;
+	float PlayerDamage = 0.f;
+
+	int32 Kills = 0;
+	int32 PlayerDeaths = 0;
+
+	/// first hit to death of every enemy killed
+	TArray<float> TimesToKill;
+
+	TArray<FVector> SpawnLocations;
+};
+
+/// Split the events of one trace into encounters
+static void CollectEncounters(const FString& File, const TArray<FCombatTraceEvent>& Events, float Gap, TArray<FCombatEncounter>& OutEncounters)
+{
+	FString Level = TEXT("(start)");
+	int32 LevelIndex = 0;
+
+	FCombatEncounter Current;
+	bool bOpen = false;
+
+	/// spawns since the last encounter, the ones shortly before the next one belong to it
+	TArray<const FCombatTraceEvent*> PendingSpawns;
+
+	/// enemies hit and still alive, pooled enemies keep their id so a spawn or death forgets it
+	TMap<uint32, float> FirstHitTimes;
+
+	auto Close = [&]()
+	{
+		if (bOpen)
+		{
+			OutEncounters.Add(Current);
+			bOpen = false;
+		}
+	};
+
+	auto Open = [&](float Time)
+	{
+		Current = FCombatEncounter();
+		Current.File = File;
+		Current.Level = Level;
+		Current.Index = ++LevelIndex;
+		Current.Start = Time;
+		Current.End = Time;
+
+		for (const FCombatTraceEvent* Spawn : PendingSpawns)
+		{
+			if (Spawn->Time >= Time - Gap)
+			{
+				Current.SpawnLocations.Add(Spawn->Location);
+			}
+		}
+		PendingSpawns.Reset();
+
+		bOpen = true;
+	};
+
+	for (const FCombatTraceEvent& Event : Events)
+	{
+		if (bOpen && Event.Time - Current.End > Gap)
+		{
+			Close();
+		}
+
+		switch (Event.Type)
+		{
+		case ECombatTraceEvent::EnemyHit:
+		case ECombatTraceEvent::PlayerHit:
+		case ECombatTraceEvent::EnemyDeath:
+		case ECombatTraceEvent::PlayerDeath:
+			if (!bOpen)
+			{
+				Open(Event.Time);
+			}
+			Current.End = Event.Time;
+
+			if (Event.Type == ECombatTraceEvent::EnemyHit)
+			{
+				Current.EnemyDamage += Event.Value;
+
+				if (!FirstHitTimes.Contains(Event.Subject))
+				{
+					FirstHitTimes.Add(Event.Subject, Event.Time);
+				}
+			} else if (Event.Type == ECombatTraceEvent::PlayerHit)
+			{
+				Current.PlayerDamage += Event.Value;
+			} else if (Event.Type == ECombatTraceEvent::EnemyDeath)
+			{
+				Current.Kills++;
+
+				float FirstHit = 0.f;
+				if (FirstHitTimes.RemoveAndCopyValue(Event.Subject, FirstHit))
+				{
+					Current.TimesToKill.Add(Event.Time - FirstHit);
+				}
+			} else
+			{
+				Current.PlayerDeaths++;
+				Close();
+			}
+			break;
+
+		case ECombatTraceEvent::Spawn:
+			FirstHitTimes.Remove(Event.Subject);
+
+			if (bOpen)
+			{
+				Current.SpawnLocations.Add(Event.Location);
+			} else
+			{
+				PendingSpawns.Add(&Event);
+			}
+			break;
+
+		case ECombatTraceEvent::LevelSwitch:
+			Close();
+			Level = Event.Name;
+			LevelIndex = 0;
+			PendingSpawns.Reset();
+			FirstHitTimes.Reset();
+			break;
+
+		default: /// pickups and saves don't change the fight
+			break;
+		}
+	}
+
+	Close();
+}
+
+static FString EncounterToCSV(const FCombatEncounter& Encounter)
+{
+	const float Duration = Encounter.End - Encounter.Start;
+
+	/// a single hit has no duration, rate it over a second
+	const float RateTime = FMath::Max(Duration, 1.f);
+
+	float AverageTTK = 0.f;
+	float MaxTTK = 0.f;
+
+	for (float TTK : Encounter.TimesToKill)
+	{
+		AverageTTK += TTK;
+		MaxTTK = FMath::Max(MaxTTK, TTK);
+	}
+	if (Encounter.TimesToKill.Num() > 0)
+	{
+		AverageTTK /= Encounter.TimesToKill.Num();
+	}
+
+	/// how spread out the spawns were, average distance from their center
+	float SpawnRadius = 0.f;
+	const int32 Spawns = Encounter.SpawnLocations.Num();
+
+	if (Spawns > 0)
+	{
+		FVector Center = FVector::ZeroVector;
+		for (const FVector& Location : Encounter.SpawnLocations)
+		{
+			Center += Location;
+		}
+		Center /= Spawns;
+
+		for (const FVector& Location : Encounter.SpawnLocations)
+		{
+			SpawnRadius += FVector::Dist(Location, Center);
+		}
+		SpawnRadius /= Spawns;
+	}
+
+	return FString::Printf(TEXT("%s,%s,%d,%.2f,%.2f,%.1f,%.1f,%.2f,%.2f,%d,%d,%.2f,%.2f,%d,%.2f,%.0f"),
+		*Encounter.File, *Encounter.Level, Encounter.Index, Encounter.Start, Duration,
+		Encounter.EnemyDamage, Encounter.PlayerDamage, Encounter.EnemyDamage / RateTime, Encounter.PlayerDamage / RateTime,
+		Encounter.Kills, Encounter.PlayerDeaths, AverageTTK, MaxTTK,
+		Spawns, Spawns * 60.f / RateTime, SpawnRadius);
+}
+
+UCombatTraceCommandlet::UCombatTraceCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = false;
+	LogToConsole = true;
+}
+
+int32 UCombatTraceCommandlet::Main(const FString& Params)
+{
+	FString InPath = UCombatTelemetrySubsystem::GetTraceDirectory();
+	FParse::Value(*Params, TEXT("in="), InPath);
+
+	FString OutPath = UCombatTelemetrySubsystem::GetTraceDirectory() / TEXT("Encounters.csv");
+	FParse::Value(*Params, TEXT("out="), OutPath);
+
+	float Gap = 10.f;
+	FParse::Value(*Params, TEXT("gap="), Gap);
+
+	TArray<FString> Files;
+
+	if (IFileManager::Get().DirectoryExists(*InPath))
+	{
+		IFileManager::Get().FindFiles(Files, *(InPath / TEXT("*.ctrace")), true, false);
+
+		for (FString& File : Files)
+		{
+			File = InPath / File;
+		}
+		Files.Sort(); /// session names start with their date
+	} else
+	{
+		Files.Add(InPath);
+	}
+
+	if (Files.Num() == 0)
+	{
+		UE_LOG(LogTemp, Error, TEXT("No combat traces in %s"), *InPath);
+		return 1;
+	}
+
+	TArray<FCombatEncounter> Encounters;
+	int32 EventCount = 0;
+
+	for (const FString& File : Files)
+	{
+		TArray<FCombatTraceEvent> Events;
+
+		if (!UCombatTelemetrySubsystem::ReadTrace(File, Events))
+		{
+			UE_LOG(LogTemp, Warning, TEXT("%s is not a combat trace, skipped"), *File);
+			continue;
+		}
+
+		EventCount += Events.Num();
+		CollectEncounters(FPaths::GetCleanFilename(File), Events, Gap, Encounters);
+	}
+
+	FString CSV = TEXT("File,Level,Encounter,Start,Duration,DamageDealt,DamageTaken,DPS,IncomingDPS,Kills,PlayerDeaths,AvgTTK,MaxTTK,Spawns,SpawnsPerMinute,SpawnRadius\n");
+
+	int32 Kills = 0;
+	for (const FCombatEncounter& Encounter : Encounters)
+	{
+		CSV += EncounterToCSV(Encounter);
+		CSV += TEXT("\n");
+
+		Kills += Encounter.Kills;
+	}
+
+	if (!FFileHelper::SaveStringToFile(CSV, *OutPath))
+	{
+		UE_LOG(LogTemp, Error, TEXT("Could not write %s"), *OutPath);
+		return 1;
+	}
+
+	UE_LOG(LogTemp, Display, TEXT("%d traces, %d events, %d encounters, %d kills written to %s"), Files.Num(), EventCount, Encounters.Num(), Kills, *OutPath);
+	return 0;
+}
\ No newline at end of file
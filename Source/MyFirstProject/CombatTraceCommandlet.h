@@ -0,0 +1,25 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "CombatTraceCommandlet.generated.h"
+
+/**
+ * Batch analysis of the combat traces, one CSV row per encounter with time to kill, damage per second and spawn density.
+ * UE4Editor-Cmd.exe MyFirstProject.uproject -run=CombatTrace [-in=Folder or .ctrace] [-out=File.csv] [-gap=Seconds]
+ * An encounter is a chain of hits and deaths with less than -gap seconds (10) between them, a level switch or
+ * the player's death ends it
+ */
+UCLASS()
+class MYFIRSTPROJECT_API UCombatTraceCommandlet: public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+
+	UCombatTraceCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
@@ -0,0 +1,44 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Corpse.h"
+#include "Components/PoseableMeshComponent.h"
+#include "Components/SkeletalMeshComponent.h"
+
+ACorpse::ACorpse()
+{
+	PrimaryActorTick.bCanEverTick = false;
+
+	PoseableMesh = CreateDefaultSubobject<UPoseableMeshComponent>(TEXT("PoseableMesh"));
+	SetRootComponent(PoseableMesh);
+	PoseableMesh->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+	PoseableMesh->SetGenerateOverlapEvents(false);
+	PoseableMesh->PrimaryComponentTick.bStartWithTickEnabled = false; /// Bake refreshes the pose itself, nothing changes after that
+
+	ExpireTime = 0.f;
+}
+
+void ACorpse::Bake(USkeletalMeshComponent* Source)
+{
+	SetActorTransform(Source->GetComponentTransform(), false, nullptr, ETeleportType::TeleportPhysics);
+
+	if (PoseableMesh->SkeletalMesh != Source->SkeletalMesh)
+	{
+		PoseableMesh->SetSkeletalMesh(Source->SkeletalMesh);
+	}
+	for (int32 i = 0; i < Source->GetNumMaterials(); i++) /// keeps material instances set at runtime (hit flashes, variants)
+	{
+		PoseableMesh->SetMaterial(i, Source->GetMaterial(i));
+	}
+
+	PoseableMesh->CopyPoseFromSkeletalComponent(Source);
+	PoseableMesh->RefreshBoneTransforms(); /// normally done by the component tick, which stays off
+	PoseableMesh->SetComponentTickEnabled(false);
+
+	SetActorHiddenInGame(false);
+}
+
+void ACorpse::Clear()
+{
+	SetActorHiddenInGame(true);
+	ExpireTime = 0.f;
+}
\ No newline at end of file
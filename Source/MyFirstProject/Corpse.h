@@ -0,0 +1,33 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "Corpse.generated.h"
+
+/**
+ * Frozen copy of a dead enemy's last pose, only a mesh with no animation, movement, AI or collision,
+ * reused by the corpse subsystem
+ */
+UCLASS()
+class MYFIRSTPROJECT_API ACorpse: public AActor
+{
+	GENERATED_BODY()
+
+public:
+
+	ACorpse();
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Corpse")
+		class UPoseableMeshComponent* PoseableMesh;
+
+	/// world time the corpse goes away, 0 to stay until evicted
+	float ExpireTime;
+
+	/// Take over the mesh, materials, transform and current pose of the source
+	void Bake(class USkeletalMeshComponent* Source);
+
+	/// Hide until the next Bake
+	void Clear();
+};
@@ -0,0 +1,136 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "CorpseSubsystem.h"
+#include "Engine/World.h"
+#include "Corpse.h"
+#include "Enemy.h"
+
+static TAutoConsoleVariable<int32> CVarMaxCorpses(
+	TEXT("game.MaxCorpses"),
+	16,
+	TEXT("Dead enemies shown as corpses at the same time, the oldest goes first, 0 keeps dead enemies as they are until DeathDelay"));
+
+static FAutoConsoleCommandWithWorld CorpseStatsCommand(
+	TEXT("Corpse.Stats"),
+	TEXT("Print corpse counters"),
+	FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+{
+	if (World)
+	{
+		if (UCorpseSubsystem* Corpses = World->GetSubsystem<UCorpseSubsystem>())
+		{
+			Corpses->LogStats();
+		}
+	}
+}));
+
+void UCorpseSubsystem::Deinitialize()
+{
+	Active.Empty();
+	Free.Empty();
+
+	Super::Deinitialize();
+}
+
+bool UCorpseSubsystem::IsTickable() const
+{
+	return Active.Num() > 0 && Super::IsTickable();
+}
+
+void UCorpseSubsystem::Tick(float DeltaTime)
+{
+	const float Now = GetWorld()->GetTimeSeconds();
+	const int32 MaxCorpses = FMath::Max(CVarMaxCorpses.GetValueOnGameThread(), 0);
+
+	/// the cap may have been lowered since
+	while (Active.Num() > MaxCorpses)
+	{
+		ReleaseCorpse(Active[0]);
+		Active.RemoveAt(0, 1, false);
+		Stats.Evicted++;
+	}
+
+	/// each enemy class has its own DeathDelay, any corpse can expire first /// keeps the oldest first order
+	for (int32 i = Active.Num() - 1; i >= 0; i--)
+	{
+		if (!IsValid(Active[i]) || (Active[i]->ExpireTime > 0.f && Active[i]->ExpireTime <= Now))
+		{
+			ReleaseCorpse(Active[i]);
+			Active.RemoveAt(i, 1, false);
+			Stats.Expired++;
+		}
+	}
+}
+
+bool UCorpseSubsystem::BakeCorpse(AEnemy* Enemy)
+{
+	const int32 MaxCorpses = CVarMaxCorpses.GetValueOnGameThread();
+
+	if (!Enemy || !Enemy->GetMesh() || !Enemy->GetMesh()->SkeletalMesh || MaxCorpses <= 0) return false;
+
+	ACorpse* Corpse = AcquireCorpse(MaxCorpses);
+	if (!Corpse) return false;
+
+	Corpse->Bake(Enemy->GetMesh());
+	Corpse->ExpireTime = Enemy->DeathDelay > 0.f ? GetWorld()->GetTimeSeconds() + Enemy->DeathDelay : 0.f; /// stays as long as the enemy itself used to
+
+	Active.Add(Corpse);
+	Stats.Baked++;
+
+	return true;
+}
+
+ACorpse* UCorpseSubsystem::AcquireCorpse(int32 MaxCorpses)
+{
+	while (Free.Num() > 0)
+	{
+		ACorpse* Corpse = Free.Pop(false);
+
+		if (IsValid(Corpse))
+		{
+			return Corpse;
+		}
+	}
+
+	if (Active.Num() >= MaxCorpses)
+	{
+		ACorpse* Oldest = Active[0];
+		Active.RemoveAt(0, 1, false);
+		Stats.Evicted++;
+
+		if (IsValid(Oldest))
+		{
+			return Oldest;
+		}
+	}
+
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+	return GetWorld()->SpawnActor<ACorpse>(ACorpse::StaticClass(), FTransform::Identity, SpawnParams);
+}
+
+void UCorpseSubsystem::ReleaseCorpse(ACorpse* Corpse)
+{
+	if (IsValid(Corpse))
+	{
+		Corpse->Clear();
+		Free.Add(Corpse);
+	}
+}
+
+FCorpseStats UCorpseSubsystem::GetStats() const
+{
+	FCorpseStats Current = Stats;
+	Current.Active = Active.Num();
+	Current.Free = Free.Num();
+	return Current;
+}
+
+void UCorpseSubsystem::LogStats() const
+{
+	const FCorpseStats Current = GetStats();
+
+	UE_LOG(LogTemp, Log, TEXT("Corpses: %d baked, %d evicted, %d expired, %d shown (cap %d), %d free"),
+		Current.Baked, Current.Evicted, Current.Expired, Current.Active, CVarMaxCorpses.GetValueOnGameThread(), Current.Free);
+}
\ No newline at end of file
@@ -0,0 +1,77 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "TickableGameplaySubsystem.h"
+#include "CorpseSubsystem.generated.h"
+
+/// Counters reported by the corpse subsystem
+USTRUCT(BlueprintType)
+struct FCorpseStats
+{
+	GENERATED_BODY()
+
+	/// Dead enemies turned into a corpse
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Corpse")
+		int32 Baked = 0;
+
+	/// Corpses removed early to stay under the cap
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Corpse")
+		int32 Evicted = 0;
+
+	/// Corpses removed at the end of their lifetime
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Corpse")
+		int32 Expired = 0;
+
+	/// Corpses currently shown
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Corpse")
+		int32 Active = 0;
+
+	/// Hidden corpses waiting to be reused
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Corpse")
+		int32 Free = 0;
+};
+
+/**
+ * Replaces dead enemies with pooled corpse actors frozen in their final pose, so the enemy itself can go back to
+ * the enemy pool right away. A corpse stays for the enemy's DeathDelay, at most game.MaxCorpses corpses are shown
+ * and the oldest one makes room for a new one
+ */
+UCLASS()
+class MYFIRSTPROJECT_API UCorpseSubsystem: public UTickableGameplaySubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	virtual void Deinitialize() override;
+
+	virtual void Tick(float DeltaTime) override;
+
+	virtual bool IsTickable() const override;
+
+	/// Copy the enemy's current pose into a corpse, false if corpses are off and the enemy should stay as it is
+	bool BakeCorpse(class AEnemy* Enemy);
+
+	UFUNCTION(BlueprintPure, Category = "Corpse")
+		FCorpseStats GetStats() const;
+
+	void LogStats() const;
+
+private:
+
+	/// a hidden corpse, the oldest shown one if the cap is reached, or a new one
+	class ACorpse* AcquireCorpse(int32 MaxCorpses);
+
+	void ReleaseCorpse(ACorpse* Corpse);
+
+	/// shown corpses, oldest first
+	UPROPERTY()
+		TArray<ACorpse*> Active;
+
+	UPROPERTY()
+		TArray<ACorpse*> Free;
+
+	FCorpseStats Stats;
+};
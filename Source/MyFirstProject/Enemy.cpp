@@ -1,348 +1,637 @@
-// Fill out your copyright notice in the Description page of Project Settings.
-
-#include "Enemy.h"
-#include "Components/SphereComponent.h"
-#include "AIController.h"
-#include "Main.h"
-#include "Kismet/KismetSystemLibrary.h"
-#include "Components/BoxComponent.h"
-#include "Components/SkeletalMeshComponent.h"
-#include "Kismet/GameplayStatics.h"
-#include "Engine/SkeletalMeshSocket.h"
-#include "Sound/SoundCue.h"
-#include "Animation/AnimInstance.h"
-#include "TimerManager.h"
-#include "Components/Capsulecomponent.h"
-#include "MainPlayerController.h"
-
-// Sets default values
-AEnemy::AEnemy()
-{
-	// Set this character to call Tick() every frame.  You can turn this off to improve performance if you don't need it.
-	PrimaryActorTick.bCanEverTick = true;
-
-	AgroSphere = CreateDefaultSubobject<USphereComponent>(TEXT("AgroSphere"));
-	AgroSphere->SetupAttachment(GetRootComponent());
-	AgroSphere->InitSphereRadius(600.f);
-
-	CombatSphere = CreateDefaultSubobject<USphereComponent>(TEXT("CombatSphere"));
-	CombatSphere->SetupAttachment(GetRootComponent());
-	CombatSphere->InitSphereRadius(75.f);
-
-	CombatCollision = CreateDefaultSubobject<UBoxComponent>(TEXT("CombatCollision"));
-	CombatCollision->SetupAttachment(GetMesh(), FName("EnemySocket"));
-
-	bOverlappingCombatSphere = false;
-
-	Health = 75.f;
-	MaxHealth = 100.f;
-	Damage = 10.f;
-
-	AttackMinTime = 0.5f;
-	AttackMaxTime = 3.5f;
-
-	EnemyMovementStatus = EEnemyMovementStatus::EMS_Idle;
-
-	DeathDelay = 3.f;
-
-	bHasValidTarget = false;
-}
-
-// Called when the game starts or when spawned
-void AEnemy::BeginPlay()
-{
-	Super::BeginPlay();
-
-	/// cast GetController to an AIController to have reference to the AIController
-	AIController = Cast<AAIController>(GetController());
-
-	AgroSphere->OnComponentBeginOverlap.AddDynamic(this, &AEnemy::AgroSphereOnOverlapBegin);
-	AgroSphere->OnComponentEndOverlap.AddDynamic(this, &AEnemy::AgroSphereOnOverlapEnd);
-	AgroSphere->SetCollisionResponseToChannel(ECollisionChannel::ECC_WorldDynamic, ECollisionResponse::ECR_Ignore); /// set collision to overlap for for pawn
-
-	CombatSphere->OnComponentBeginOverlap.AddDynamic(this, &AEnemy::CombatSphereOnOverlapBegin);
-	CombatSphere->OnComponentEndOverlap.AddDynamic(this, &AEnemy::CombatSphereOnOverlapEnd);
-
-	CombatCollision->OnComponentBeginOverlap.AddDynamic(this, &AEnemy::CombatOnOverlapBegin);
-	CombatCollision->OnComponentEndOverlap.AddDynamic(this, &AEnemy::CombatOnOverlapEnd);
-
-	CombatCollision->SetCollisionEnabled(ECollisionEnabled::NoCollision); /// to do not generate overlap events
-	CombatCollision->SetCollisionObjectType(ECollisionChannel::ECC_WorldDynamic); /// automatic overlap parameters set
-	CombatCollision->SetCollisionResponseToAllChannels(ECollisionResponse::ECR_Ignore); /// ignore all channels collision by defaults
-	CombatCollision->SetCollisionResponseToChannel(ECollisionChannel::ECC_Pawn, ECollisionResponse::ECR_Overlap); /// set collision to overlap for for pawn
-
-	GetMesh()->SetCollisionResponseToChannel(ECollisionChannel::ECC_Camera, ECollisionResponse::ECR_Ignore);
-	GetCapsuleComponent()->SetCollisionResponseToChannel(ECollisionChannel::ECC_Camera, ECollisionResponse::ECR_Ignore);
-}
-
-// Called every frame
-void AEnemy::Tick(float DeltaTime)
-{
-	Super::Tick(DeltaTime);
-}
-
-// Called to bind functionality to input
-void AEnemy::SetupPlayerInputComponent(UInputComponent* PlayerInputComponent)
-{
-	Super::SetupPlayerInputComponent(PlayerInputComponent);
-}
-
-void AEnemy::AgroSphereOnOverlapBegin(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult)
-{
-	if (OtherActor && Alive()) /// cast OtherActor to AMain and move to the player
-	{
-		AMain* Main = Cast<AMain>(OtherActor);
-
-		if (Main)
-		{
-			MoveToTarget(Main);
-		}
-	}
-}
-
-void AEnemy::AgroSphereOnOverlapEnd(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex)
-{
-	if (OtherActor) /// cast OtherActor to AMain and move to the player
-	{
-		AMain* Main = Cast<AMain>(OtherActor);
-
-		if (Main)
-		{
-			bHasValidTarget = false;
-
-			if (Main->CombatTarget == this)
-			{
-				Main->SetCombatTarget(nullptr);
-			}
-
-			Main->SetHasCombatTarget(false);
-
-			Main->UpdateCombatTarget();
-
-			SetEnemyMovementStatus(EEnemyMovementStatus::EMS_Idle);
-
-			if (AIController)
-			{
-				AIController->StopMovement();
-			}
-		}
-	}
-}
-
-void AEnemy::CombatSphereOnOverlapBegin(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult)
-{
-	if (OtherActor && Alive()) /// cast OtherActor to AMain and move to the player
-	{
-		AMain* Main = Cast<AMain>(OtherActor);
-
-		if (Main)
-		{
-			bHasValidTarget = true;
-
-			Main->SetCombatTarget(this);
-			Main->SetHasCombatTarget(true);
-
-			Main->UpdateCombatTarget();
-
-			CombatTarget = Main;
-			bOverlappingCombatSphere = true;
-
-			float AttackTime = FMath::FRandRange(AttackMinTime, AttackMaxTime);
-			GetWorldTimerManager().SetTimer(AttackTimer, this, &AEnemy::Attack, AttackTime);
-		}
-	}
-}
-
-void AEnemy::CombatSphereOnOverlapEnd(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex)
-{
-	if (OtherActor && OtherComp && Alive())
-	{
-		AMain* Main = Cast<AMain>(OtherActor); /// cast OtherActor to AMain and move to the player
-
-		if (Main)
-		{
-			bOverlappingCombatSphere = false;
-			MoveToTarget(Main);
-			CombatTarget = nullptr;
-
-			if (Main->CombatTarget == this)
-			{
-				Main->SetCombatTarget(nullptr);
-				Main->bHasCombatTarget = false;
-				Main->UpdateCombatTarget();
-			}
-			if (Main->MainPlayerController)
-			{
-				USkeletalMeshComponent* MainMesh = Cast<USkeletalMeshComponent>(OtherComp);
-
-				if (MainMesh) Main->MainPlayerController->RemoveEnemyHealthBar();
-			}
-
-			GetWorldTimerManager().ClearTimer(AttackTimer);
-		}
-	}
-}
-
-void AEnemy::MoveToTarget(class AMain* Target)
-{
-	if (Alive())
-	{
-		SetEnemyMovementStatus(EEnemyMovementStatus::EMS_MoveToTarget);
-
-		if (AIController)
-		{
-			FAIMoveRequest MoveRequest;
-			MoveRequest.SetGoalActor(Target); /// set the move target to an AActor/APawn/ACharacter
-			MoveRequest.SetAcceptanceRadius(1.0f); /// collision space between two collision spheres
-
-			FNavPathSharedPtr NavPath; /// will be filled with information when finished MoveTo()
-
-			AIController->MoveTo(MoveRequest, &NavPath);
-		}
-	}
-}
-
-void AEnemy::CombatOnOverlapBegin(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult)
-{
-	if (OtherActor)
-	{
-		AMain* Main = Cast<AMain>(OtherActor);
-
-		if (Main)
-		{
-			if (Main->HitParticles)
-			{
-				/// Spawn particles on the socket attached to weapon when hitting an enemy
-				const USkeletalMeshSocket* TipSocket = GetMesh()->GetSocketByName("TipSocket");
-				if (TipSocket)
-				{
-					FVector SocketLocation = TipSocket->GetSocketLocation(GetMesh());
-					UGameplayStatics::SpawnEmitterAtLocation(GetWorld(), Main->HitParticles, SocketLocation, FRotator(0.f), false);
-				}
-				/// play hit sound when sword hit the enemy capsule
-				if (Main->HitSound)
-				{
-					UGameplayStatics::PlaySound2D(this, Main->HitSound);
-				}
-
-				if (DamageTypeClass)
-				{
-					UGameplayStatics::ApplyDamage(Main, Damage, AIController, this, DamageTypeClass);
-				}
-			}
-		}
-	}
-}
-
-void AEnemy::CombatOnOverlapEnd(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex)
-{
-}
-
-void AEnemy::ActivateCollision()
-{
-	CombatCollision->SetCollisionEnabled(ECollisionEnabled::QueryOnly); ///  generate overlap events to specific target
-
-	if (SwingSound)
-	{
-		UGameplayStatics::PlaySound2D(this, SwingSound);
-	}
-}
-
-void AEnemy::DeActivateCollision()
-{
-	CombatCollision->SetCollisionEnabled(ECollisionEnabled::NoCollision); /// to do not generate overlap events
-}
-
-void AEnemy::Attack()
-{
-	if (Alive() && bHasValidTarget)
-	{
-		if (AIController)
-		{
-			AIController->StopMovement();
-			SetEnemyMovementStatus(EEnemyMovementStatus::EMS_Attacking);
-		}
-		if (!bAttacking)
-		{
-			bAttacking = true;
-			UAnimInstance* AnimInstance = GetMesh()->GetAnimInstance();
-
-			if (AnimInstance)
-			{
-				AnimInstance->Montage_Play(CombatMontage, 1.35f);
-				AnimInstance->Montage_JumpToSection(FName("Attack"));
-			}
-		}
-	}
-}
-
-void AEnemy::AttackEnd()
-{
-	bAttacking = false;
-	UE_LOG(LogTemp, Warning, TEXT("AttackEnd"));
-
-	if (bOverlappingCombatSphere)
-	{
-		float AttackTime = FMath::FRandRange(AttackMinTime, AttackMaxTime);
-		GetWorldTimerManager().SetTimer(AttackTimer, this, &AEnemy::Attack, AttackTime);
-	}
-}
-
-float AEnemy::TakeDamage(float DamageAmount, FDamageEvent const& DamageEvent, AController* EventInstigator, AActor* DamageCauser)
-{
-	if (Health - DamageAmount <= 0.f)
-	{
-		Health = 0.f;
-		Die(DamageCauser);
-	} else
-	{
-		Health -= DamageAmount;
-	}
-	return DamageAmount;
-}
-
-void AEnemy::Die(AActor* Causer)
-{
-	CombatTarget = nullptr;
-
-	CombatCollision->SetCollisionEnabled(ECollisionEnabled::NoCollision);
-	AgroSphere->SetCollisionEnabled(ECollisionEnabled::NoCollision);
-	CombatSphere->SetCollisionEnabled(ECollisionEnabled::NoCollision);
-	GetCapsuleComponent()->SetCollisionEnabled(ECollisionEnabled::NoCollision);
-
-	bAttacking = false;
-
-	SetEnemyMovementStatus(EEnemyMovementStatus::EMS_Dead);
-
-	UAnimInstance* AnimInstance = GetMesh()->GetAnimInstance(); /// get AnimeInstance from the mesh
-
-	if (AnimInstance) /// check if anime instance is valid, play the selected montage and jump to Attack_1 section
-	{
-		AnimInstance->Montage_Play(CombatMontage, 1.0f);
-		AnimInstance->Montage_JumpToSection(FName("Death"), CombatMontage);
-	}
-
-	AMain* Main = Cast<AMain>(Causer);
-	if (Main)
-	{
-		Main->UpdateCombatTarget();
-	}
-}
-
-void AEnemy::DeathEnd()
-{
-	GetMesh()->bPauseAnims = true;
-	GetMesh()->bNoSkeletonUpdate = true;
-
-	GetWorldTimerManager().SetTimer(DeathTimer, this, &AEnemy::Disappear, DeathDelay);
-}
-
-bool AEnemy::Alive()
-{
-	return GetEnemyMovementStatus() != EEnemyMovementStatus::EMS_Dead;
-}
-
-void AEnemy::Disappear()
-{
-	Destroy();
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Enemy.h"
+#include "Components/SphereComponent.h"
+#include "AIController.h"
+#include "Main.h"
+#include "Kismet/KismetSystemLibrary.h"
+#include "Components/BoxComponent.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "Kismet/GameplayStatics.h"
+#include "Engine/SkeletalMeshSocket.h"
+#include "Sound/SoundCue.h"
+#include "Animation/AnimInstance.h"
+#include "Animation/AnimMontage.h"
+#include "Particles/ParticleSystem.h"
+#include "TimerManager.h"
+#include "Components/Capsulecomponent.h"
+#include "MainPlayerController.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "EnemyPoolSubsystem.h"
+#include "SpatialGridSubsystem.h"
+#include "EnemySignificanceSubsystem.h"
+#include "CombatFXSubsystem.h"
+#include "AssetPreloadSubsystem.h"
+#include "MeleeTraceComponent.h"
+#include "AttackSchedulerSubsystem.h"
+#include "FlowFieldSubsystem.h"
+#include "EnemyMeshComponent.h"
+#include "AnimationBudgetSubsystem.h"
+#include "CorpseSubsystem.h"
+#include "GameplayPerf.h"
+#include "CombatTelemetrySubsystem.h"
+#include "TickGovernanceSubsystem.h"
+
+// Sets default values
+AEnemy::AEnemy(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer.SetDefaultSubobjectClass<UEnemyMeshComponent>(ACharacter::MeshComponentName)) /// measures its tick for the animation budget
+{
+	// Set this character to call Tick() every frame.  You can turn this off to improve performance if you don't need it.
+	PrimaryActorTick.bCanEverTick = true;
+	PrimaryActorTick.bStartWithTickEnabled = false; /// nothing to do per frame natively, only a Blueprint Event Tick needs this
+
+	AgroSphere = CreateDefaultSubobject<USphereComponent>(TEXT("AgroSphere"));
+	AgroSphere->SetupAttachment(GetRootComponent());
+	AgroSphere->InitSphereRadius(600.f);
+
+	CombatSphere = CreateDefaultSubobject<USphereComponent>(TEXT("CombatSphere"));
+	CombatSphere->SetupAttachment(GetRootComponent());
+	CombatSphere->InitSphereRadius(75.f);
+
+	GetMesh()->bEnableUpdateRateOptimizations = true; /// distant and small enemies update their animation less often, interpolating in between
+
+	CombatCollision = CreateDefaultSubobject<UBoxComponent>(TEXT("CombatCollision"));
+	CombatCollision->SetupAttachment(GetMesh(), FName("EnemySocket"));
+
+	MeleeTrace = CreateDefaultSubobject<UMeleeTraceComponent>(TEXT("MeleeTrace"));
+	MeleeTrace->TargetClass = AMain::StaticClass();
+	MeleeTrace->MaxTargets = 1;
+
+	bOverlappingCombatSphere = false;
+
+	Health = 75.f;
+	MaxHealth = 100.f;
+	Damage = 10.f;
+
+	AttackMinTime = 0.5f;
+	AttackMaxTime = 3.5f;
+
+	EnemyMovementStatus = EEnemyMovementStatus::EMS_Idle;
+
+	DeathDelay = 3.f;
+
+	bHasValidTarget = false;
+
+	ChaseTarget = nullptr;
+	LastMoveToTime = 0.f;
+	bUseFlowField = true;
+	SignificanceTier = -1;
+
+	/// Near: exactly the full cost behaviour
+	FEnemySignificanceTier Near;
+	Near.MaxDistance = 1500.f;
+	SignificanceTiers.Add(Near);
+
+	/// Mid: a bit less smooth, still chasing precisely enough
+	FEnemySignificanceTier Mid;
+	Mid.MaxDistance = 3000.f;
+	Mid.MovementTickInterval = 0.05f;
+	Mid.AnimTickInterval = 0.05f;
+	Mid.RepathInterval = 0.5f;
+	SignificanceTiers.Add(Mid);
+
+	/// Far: barely updated, can't notice the player
+	FEnemySignificanceTier Far;
+	Far.MaxDistance = 6000.f;
+	Far.MovementTickInterval = 0.25f;
+	Far.AnimTickInterval = 0.25f;
+	Far.RepathInterval = 2.f;
+	Far.bAgroSphereOverlaps = false;
+	SignificanceTiers.Add(Far);
+
+	/// Dormant: everything beyond Far
+	FEnemySignificanceTier Dormant;
+	Dormant.MaxDistance = BIG_NUMBER;
+	Dormant.MovementTickInterval = 1.f;
+	Dormant.AnimTickInterval = 1.f;
+	Dormant.RepathInterval = 4.f;
+	Dormant.bAgroSphereOverlaps = false;
+	SignificanceTiers.Add(Dormant);
+}
+
+// Called when the game starts or when spawned
+void AEnemy::BeginPlay()
+{
+	Super::BeginPlay();
+
+	/// cast GetController to an AIController to have reference to the AIController
+	AIController = Cast<AAIController>(GetController());
+
+	SetActorTickEnabled(UTickGovernanceSubsystem::HasBlueprintTick(this));
+
+	AgroSphere->OnComponentBeginOverlap.AddDynamic(this, &AEnemy::AgroSphereOnOverlapBegin);
+	AgroSphere->OnComponentEndOverlap.AddDynamic(this, &AEnemy::AgroSphereOnOverlapEnd);
+	AgroSphere->SetCollisionResponseToChannel(ECollisionChannel::ECC_WorldDynamic, ECollisionResponse::ECR_Ignore); /// set collision to overlap for for pawn
+
+	CombatSphere->OnComponentBeginOverlap.AddDynamic(this, &AEnemy::CombatSphereOnOverlapBegin);
+	CombatSphere->OnComponentEndOverlap.AddDynamic(this, &AEnemy::CombatSphereOnOverlapEnd);
+
+	CombatCollision->SetCollisionEnabled(ECollisionEnabled::NoCollision); /// only its shape is used, swept by MeleeTrace
+
+	MeleeTrace->SetTraceShape(CombatCollision);
+	MeleeTrace->OnHit.BindUObject(this, &AEnemy::OnMeleeHit);
+
+	GetMesh()->SetCollisionResponseToChannel(ECollisionChannel::ECC_Camera, ECollisionResponse::ECR_Ignore);
+	GetCapsuleComponent()->SetCollisionResponseToChannel(ECollisionChannel::ECC_Camera, ECollisionResponse::ECR_Ignore);
+
+	RegisterLiveEnemy();
+
+	if (UAssetPreloadSubsystem* Preload = GetWorld()->GetSubsystem<UAssetPreloadSubsystem>()) /// keeps the hit FX, sounds and montage loaded while this enemy is around
+	{
+		Preload->AddInstance(this);
+	}
+}
+
+void AEnemy::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	UnregisterLiveEnemy();
+
+	if (UAssetPreloadSubsystem* Preload = GetWorld()->GetSubsystem<UAssetPreloadSubsystem>())
+	{
+		Preload->RemoveInstance(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
+// Called every frame
+void AEnemy::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+}
+
+// Called to bind functionality to input
+void AEnemy::SetupPlayerInputComponent(UInputComponent* PlayerInputComponent)
+{
+	Super::SetupPlayerInputComponent(PlayerInputComponent);
+}
+
+void AEnemy::AgroSphereOnOverlapBegin(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult)
+{
+	GAMEPLAY_PERF_SCOPE(EnemyOverlaps);
+	GAMEPLAY_PERF_COUNT_OVERLAP();
+
+	if (OtherActor && Alive()) /// cast OtherActor to AMain and move to the player
+	{
+		AMain* Main = Cast<AMain>(OtherActor);
+
+		if (Main)
+		{
+			MoveToTarget(Main);
+		}
+	}
+}
+
+void AEnemy::AgroSphereOnOverlapEnd(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex)
+{
+	GAMEPLAY_PERF_SCOPE(EnemyOverlaps);
+	GAMEPLAY_PERF_COUNT_OVERLAP();
+
+	if (OtherActor) /// cast OtherActor to AMain and move to the player
+	{
+		AMain* Main = Cast<AMain>(OtherActor);
+
+		if (Main)
+		{
+			bHasValidTarget = false;
+			ChaseTarget = nullptr;
+
+			if (Main->CombatTarget == this)
+			{
+				Main->SetCombatTarget(nullptr);
+			}
+
+			Main->SetHasCombatTarget(false);
+
+			Main->UpdateCombatTarget();
+
+			SetEnemyMovementStatus(EEnemyMovementStatus::EMS_Idle);
+
+			if (AIController)
+			{
+				AIController->StopMovement();
+			}
+		}
+	}
+}
+
+void AEnemy::CombatSphereOnOverlapBegin(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult)
+{
+	GAMEPLAY_PERF_SCOPE(EnemyOverlaps);
+	GAMEPLAY_PERF_COUNT_OVERLAP();
+
+	if (OtherActor && Alive()) /// cast OtherActor to AMain and move to the player
+	{
+		AMain* Main = Cast<AMain>(OtherActor);
+
+		if (Main)
+		{
+			bHasValidTarget = true;
+
+			Main->SetCombatTarget(this);
+			Main->SetHasCombatTarget(true);
+
+			Main->UpdateCombatTarget();
+
+			CombatTarget = Main;
+			bOverlappingCombatSphere = true;
+
+			QueueAttack();
+		}
+	}
+}
+
+void AEnemy::CombatSphereOnOverlapEnd(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex)
+{
+	GAMEPLAY_PERF_SCOPE(EnemyOverlaps);
+	GAMEPLAY_PERF_COUNT_OVERLAP();
+
+	if (OtherActor && OtherComp && Alive())
+	{
+		AMain* Main = Cast<AMain>(OtherActor); /// cast OtherActor to AMain and move to the player
+
+		if (Main)
+		{
+			bOverlappingCombatSphere = false;
+			MoveToTarget(Main);
+			CombatTarget = nullptr;
+
+			if (Main->CombatTarget == this)
+			{
+				Main->SetCombatTarget(nullptr);
+				Main->bHasCombatTarget = false;
+				Main->UpdateCombatTarget();
+			}
+			if (Main->MainPlayerController)
+			{
+				USkeletalMeshComponent* MainMesh = Cast<USkeletalMeshComponent>(OtherComp);
+
+				if (MainMesh) Main->MainPlayerController->RemoveEnemyHealthBar();
+			}
+
+			ClearQueuedAttack();
+		}
+	}
+}
+
+void AEnemy::MoveToTarget(class AMain* Target)
+{
+	if (Alive())
+	{
+		SetEnemyMovementStatus(EEnemyMovementStatus::EMS_MoveToTarget);
+
+		ChaseTarget = Target;
+		LastMoveToTime = GetWorld()->GetTimeSeconds();
+
+		UFlowFieldSubsystem* FlowField = GetWorld()->GetSubsystem<UFlowFieldSubsystem>();
+
+		if (FlowField && FlowField->StartFollowing(this)) return; /// steered by the flow field until it gets close
+
+		if (AIController)
+		{
+			FAIMoveRequest MoveRequest;
+
+			if (GetSignificanceSettings().RepathInterval <= 0.f)
+			{
+				MoveRequest.SetGoalActor(Target); /// set the move target to an AActor/APawn/ACharacter
+			} else /// cheaper fixed goal, the significance subsystem re-issues it every RepathInterval
+			{
+				MoveRequest.SetGoalLocation(Target->GetActorLocation());
+			}
+			MoveRequest.SetAcceptanceRadius(1.0f); /// collision space between two collision spheres
+
+			FNavPathSharedPtr NavPath; /// will be filled with information when finished MoveTo()
+
+			AIController->MoveTo(MoveRequest, &NavPath);
+		}
+	}
+}
+
+void AEnemy::OnMeleeHit(const FHitResult& Hit)
+{
+	GAMEPLAY_PERF_SCOPE(MeleeHits);
+
+	if (AActor* OtherActor = Hit.GetActor())
+	{
+		AMain* Main = Cast<AMain>(OtherActor);
+
+		if (Main)
+		{
+			if (!Main->HitParticles.IsNull())
+			{
+				/// Spawn particles on the socket attached to weapon when hitting an enemy
+				const USkeletalMeshSocket* TipSocket = GetMesh()->GetSocketByName("TipSocket");
+				FVector SocketLocation = TipSocket ? TipSocket->GetSocketLocation(GetMesh()) : GetActorLocation();
+
+				UCombatFXSubsystem* FX = GetWorld()->GetSubsystem<UCombatFXSubsystem>();
+				if (FX)
+				{
+					/// pooled particles/sound, merged with other hits of this frame /// particles only when the socket exists like before
+					FX->PlayHitEffect(TipSocket ? Main->HitParticles.Get() : nullptr, Main->HitSound.Get(), SocketLocation); /// skipped while still streaming in
+				}
+
+				if (DamageTypeClass)
+				{
+					UGameplayStatics::ApplyDamage(Main, Damage, AIController, this, DamageTypeClass);
+				}
+			}
+		}
+	}
+}
+
+void AEnemy::ActivateCollision()
+{
+	MeleeTrace->BeginSwing(); /// the player is hit at most once per swing
+
+	UCombatFXSubsystem* FX = GetWorld()->GetSubsystem<UCombatFXSubsystem>();
+	if (SwingSound.Get() && FX)
+	{
+		FX->PlaySound2D(SwingSound.Get(), GetActorLocation());
+	}
+}
+
+void AEnemy::DeActivateCollision()
+{
+	MeleeTrace->EndSwing();
+}
+
+void AEnemy::Attack()
+{
+	if (Alive() && bHasValidTarget)
+	{
+		if (AIController)
+		{
+			AIController->StopMovement();
+			SetEnemyMovementStatus(EEnemyMovementStatus::EMS_Attacking);
+		}
+		if (!bAttacking)
+		{
+			bAttacking = true;
+			UAnimInstance* AnimInstance = GetMesh()->GetAnimInstance();
+
+			if (AnimInstance)
+			{
+				AnimInstance->Montage_Play(CombatMontage.LoadSynchronous(), 1.35f); /// preloaded, only blocks if the preloader missed it
+				AnimInstance->Montage_JumpToSection(FName("Attack"));
+			}
+		}
+	}
+}
+
+void AEnemy::AttackEnd()
+{
+	bAttacking = false;
+	UE_LOG(LogTemp, Warning, TEXT("AttackEnd"));
+
+	if (UAttackSchedulerSubsystem* Scheduler = GetWorld()->GetSubsystem<UAttackSchedulerSubsystem>())
+	{
+		Scheduler->ReleaseToken(this);
+	}
+
+	if (bOverlappingCombatSphere)
+	{
+		QueueAttack();
+	}
+}
+
+void AEnemy::QueueAttack()
+{
+	if (UAttackSchedulerSubsystem* Scheduler = GetWorld()->GetSubsystem<UAttackSchedulerSubsystem>())
+	{
+		Scheduler->ScheduleAttack(this, FMath::FRandRange(AttackMinTime, AttackMaxTime));
+	}
+}
+
+void AEnemy::ClearQueuedAttack()
+{
+	if (UAttackSchedulerSubsystem* Scheduler = GetWorld()->GetSubsystem<UAttackSchedulerSubsystem>())
+	{
+		Scheduler->CancelAttack(this);
+		Scheduler->ReleaseToken(this);
+	}
+}
+
+float AEnemy::TakeDamage(float DamageAmount, FDamageEvent const& DamageEvent, AController* EventInstigator, AActor* DamageCauser)
+{
+	UCombatTelemetrySubsystem::Record(this, ECombatTraceEvent::EnemyHit, GetActorLocation(), this, DamageAmount);
+
+	if (Health - DamageAmount <= 0.f)
+	{
+		Health = 0.f;
+		Die(DamageCauser);
+	} else
+	{
+		Health -= DamageAmount;
+	}
+	return DamageAmount;
+}
+
+void AEnemy::Die(AActor* Causer)
+{
+	UCombatTelemetrySubsystem::Record(this, ECombatTraceEvent::EnemyDeath, GetActorLocation(), this);
+
+	CombatTarget = nullptr;
+
+	ClearQueuedAttack();
+	MeleeTrace->CancelSwing();
+	AgroSphere->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+	CombatSphere->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+	GetCapsuleComponent()->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+
+	bAttacking = false;
+
+	SetEnemyMovementStatus(EEnemyMovementStatus::EMS_Dead);
+
+	UnregisterLiveEnemy(); /// dead enemies can't be targeted anymore
+
+	UAnimInstance* AnimInstance = GetMesh()->GetAnimInstance(); /// get AnimeInstance from the mesh
+
+	if (AnimInstance) /// check if anime instance is valid, play the selected montage and jump to Attack_1 section
+	{
+		UAnimMontage* Montage = CombatMontage.LoadSynchronous();
+		AnimInstance->Montage_Play(Montage, 1.0f);
+		AnimInstance->Montage_JumpToSection(FName("Death"), Montage);
+	}
+
+	AMain* Main = Cast<AMain>(Causer);
+	if (Main)
+	{
+		Main->UpdateCombatTarget();
+	}
+}
+
+void AEnemy::DeathEnd()
+{
+	UCorpseSubsystem* Corpses = GetWorld()->GetSubsystem<UCorpseSubsystem>();
+
+	if (Corpses && Corpses->BakeCorpse(this)) /// a frozen copy stays behind, the enemy itself is free right away
+	{
+		Disappear();
+		return;
+	}
+
+	GetMesh()->bPauseAnims = true;
+	GetMesh()->bNoSkeletonUpdate = true;
+
+	GetWorldTimerManager().SetTimer(DeathTimer, this, &AEnemy::Disappear, DeathDelay);
+}
+
+bool AEnemy::Alive()
+{
+	return GetEnemyMovementStatus() != EEnemyMovementStatus::EMS_Dead;
+}
+
+void AEnemy::Disappear()
+{
+	UEnemyPoolSubsystem* Pool = GetWorld()->GetSubsystem<UEnemyPoolSubsystem>();
+
+	if (!Pool || !Pool->Release(this)) /// enemies placed in the level aren't owned by the pool
+	{
+		Destroy();
+	}
+}
+
+void AEnemy::DeactivateForPool()
+{
+	ClearQueuedAttack();
+	GetWorldTimerManager().ClearTimer(DeathTimer);
+
+	if (AIController)
+	{
+		AIController->StopMovement();
+	}
+
+	GetCharacterMovement()->StopMovementImmediately();
+	GetCharacterMovement()->DisableMovement();
+	GetCharacterMovement()->SetComponentTickEnabled(false);
+
+	GetMesh()->SetComponentTickEnabled(false);
+
+	UnregisterLiveEnemy();
+
+	if (UAssetPreloadSubsystem* Preload = GetWorld()->GetSubsystem<UAssetPreloadSubsystem>()) /// pooled enemies don't need their assets until a spawner nearby wants them
+	{
+		Preload->RemoveInstance(this);
+	}
+
+	SetActorEnableCollision(false); /// no overlap events while waiting in the pool
+	SetActorHiddenInGame(true);
+	SetActorTickEnabled(false);
+}
+
+void AEnemy::ActivateFromPool()
+{
+	ResetForReuse();
+
+	GetMesh()->SetComponentTickEnabled(true);
+
+	GetCharacterMovement()->SetComponentTickEnabled(true);
+	GetCharacterMovement()->SetMovementMode(EMovementMode::MOVE_Walking);
+
+	SetActorHiddenInGame(false);
+	SetActorTickEnabled(UTickGovernanceSubsystem::HasBlueprintTick(this));
+	SetActorEnableCollision(true); /// will fire AgroSphere/CombatSphere overlaps if the player is already around
+
+	RegisterLiveEnemy();
+
+	if (UAssetPreloadSubsystem* Preload = GetWorld()->GetSubsystem<UAssetPreloadSubsystem>())
+	{
+		Preload->AddInstance(this);
+	}
+}
+
+void AEnemy::ResetForReuse()
+{
+	/// use the class defaults (including blueprint overrides) as the fresh state
+	const AEnemy* Defaults = GetClass()->GetDefaultObject<AEnemy>();
+
+	Health = Defaults->Health;
+	MaxHealth = Defaults->MaxHealth;
+
+	SetEnemyMovementStatus(EEnemyMovementStatus::EMS_Idle);
+
+	bAttacking = false;
+	bOverlappingCombatSphere = false;
+	bHasValidTarget = false;
+	CombatTarget = nullptr;
+	ChaseTarget = nullptr;
+
+	ClearQueuedAttack();
+	GetWorldTimerManager().ClearTimer(DeathTimer);
+
+	/// Die() disabled every collision, give back the template settings
+	AgroSphere->SetCollisionEnabled(Defaults->AgroSphere->GetCollisionEnabled());
+	CombatSphere->SetCollisionEnabled(Defaults->CombatSphere->GetCollisionEnabled());
+	GetCapsuleComponent()->SetCollisionEnabled(Defaults->GetCapsuleComponent()->GetCollisionEnabled());
+	MeleeTrace->CancelSwing(); /// only started from the attack AnimNotify
+
+	/// DeathEnd() froze the skeleton
+	GetMesh()->bPauseAnims = false;
+	GetMesh()->bNoSkeletonUpdate = false;
+
+	UAnimInstance* AnimInstance = GetMesh()->GetAnimInstance();
+
+	if (AnimInstance)
+	{
+		AnimInstance->StopAllMontages(0.f);
+	}
+}
+
+void AEnemy::ApplySignificanceTier(int32 Tier)
+{
+	if (Tier == SignificanceTier || !SignificanceTiers.IsValidIndex(Tier)) return;
+
+	SignificanceTier = Tier;
+	const FEnemySignificanceTier& Settings = SignificanceTiers[Tier];
+
+	GetCharacterMovement()->SetComponentTickInterval(Settings.MovementTickInterval);
+	GetMesh()->SetComponentTickInterval(UAnimationBudgetSubsystem::IsEnabled() ? 0.f : Settings.AnimTickInterval); /// the budget picks the update rate instead
+	AgroSphere->SetGenerateOverlapEvents(Settings.bAgroSphereOverlaps);
+
+	/// a running chase keeps the move it was started with, restart it so it follows the actor or repaths as this tier wants
+	if (ChaseTarget && EnemyMovementStatus == EEnemyMovementStatus::EMS_MoveToTarget)
+	{
+		MoveToTarget(ChaseTarget);
+	}
+}
+
+const FEnemySignificanceTier& AEnemy::GetSignificanceSettings() const
+{
+	static const FEnemySignificanceTier FullCost;
+
+	return SignificanceTiers.IsValidIndex(SignificanceTier) ? SignificanceTiers[SignificanceTier] : FullCost;
+}
+
+void AEnemy::RegisterLiveEnemy()
+{
+	if (USpatialGridSubsystem* SpatialGrid = GetWorld()->GetSubsystem<USpatialGridSubsystem>())
+	{
+		SpatialGrid->Register(this, ESpatialGridCategory::ESGC_Enemy, true);
+	}
+	if (UEnemySignificanceSubsystem* Significance = GetWorld()->GetSubsystem<UEnemySignificanceSubsystem>())
+	{
+		Significance->Register(this);
+	}
+	if (UAnimationBudgetSubsystem* AnimationBudget = GetWorld()->GetSubsystem<UAnimationBudgetSubsystem>())
+	{
+		AnimationBudget->Register(this);
+	}
+}
+
+void AEnemy::UnregisterLiveEnemy()
+{
+	if (USpatialGridSubsystem* SpatialGrid = GetWorld()->GetSubsystem<USpatialGridSubsystem>())
+	{
+		SpatialGrid->Unregister(this);
+	}
+	if (UEnemySignificanceSubsystem* Significance = GetWorld()->GetSubsystem<UEnemySignificanceSubsystem>())
+	{
+		Significance->Unregister(this);
+	}
+	if (UAnimationBudgetSubsystem* AnimationBudget = GetWorld()->GetSubsystem<UAnimationBudgetSubsystem>())
+	{
+		AnimationBudget->Unregister(this);
+	}
+
+	ApplySignificanceTier(0); /// dying and pooled enemies go back to full cost so their death montage plays normally
 }
\ No newline at end of file
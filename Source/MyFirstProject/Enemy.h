@@ -1,164 +1,215 @@
-// Fill out your copyright notice in the Description page of Project Settings.
-
-#pragma once
-
-#include "CoreMinimal.h"
-#include "GameFramework/Character.h"
-#include "Enemy.generated.h"
-
-UENUM(BlueprintType)
-enum class EEnemyMovementStatus:uint8
-{
-	EMS_Idle			UMETA(DisplayName = "Idle"),
-	EMS_MoveToTarget	UMETA(DisplayName = "MoveToTarget"),
-	EMS_Attacking		UMETA(DisplayName = "Attacking"),
-	EMS_Dead			UMETA(DisplayName = "Dead"),
-
-	EMS_MAX				UMETA(DisplayName = "DefaultMax")
-};
-
-UCLASS()
-class MYFIRSTPROJECT_API AEnemy: public ACharacter
-{
-	GENERATED_BODY()
-
-public:
-	// Sets default values for this character's properties
-	AEnemy();
-
-	/// to set enemy movement status for playing animation
-	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Movement")
-		EEnemyMovementStatus EnemyMovementStatus;
-
-	/// sphere to let enemy start chasing player on overlap
-	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "AI")
-		class USphereComponent* AgroSphere;
-
-	/// sphere to let enemy start attacking player on overlap
-	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "AI")
-		USphereComponent* CombatSphere;
-
-	/// to call moveTo function /// this is a reference to the AI controller
-	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "AI")
-		class AAIController* AIController;
-
-	UPROPERTY(VisibleAnywhere, BlueprintReadWrite, Category = "AI")
-		bool bOverlappingCombatSphere;
-
-	UPROPERTY(VisibleAnywhere, BlueprintReadWrite, Category = "AI")
-		AMain* CombatTarget;
-
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AI")
-		float Health;
-
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AI")
-		float MaxHealth;
-
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AI")
-		float Damage;
-
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AI")
-		class UParticleSystem* HitParticles;
-
-	/// sound to play when hitting
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AI")
-		class USoundCue* HitSound;
-
-	/// sound to play when attacking
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AI")
-		USoundCue* SwingSound;
-
-	UPROPERTY(VisibleAnywhere, BlueprintReadWrite, Category = "Combat")
-		class UBoxComponent* CombatCollision;
-
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Combat")
-		class UAnimMontage* CombatMontage;
-
-	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Combat")
-		bool bAttacking;
-
-	FTimerHandle AttackTimer;
-
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Combat")
-		float AttackMinTime;
-
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Combat")
-		float AttackMaxTime;
-
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Combat")
-		TSubclassOf<UDamageType> DamageTypeClass;
-
-	FTimerHandle DeathTimer;
-
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Combat")
-		float DeathDelay;
-
-	bool bHasValidTarget;
-
-protected:
-	// Called when the game starts or when spawned
-	virtual void BeginPlay() override;
-
-public:
-	// Called every frame
-	virtual void Tick(float DeltaTime) override;
-
-	// Called to bind functionality to input
-	virtual void SetupPlayerInputComponent(class UInputComponent* PlayerInputComponent) override;
-
-	UFUNCTION(BlueprintCallable)
-		void SetEnemyMovementStatus(EEnemyMovementStatus Status) { EnemyMovementStatus = Status; }
-
-	FORCEINLINE EEnemyMovementStatus GetEnemyMovementStatus() { return EnemyMovementStatus; }
-
-	/// start chasing the player /// moving toward the player when overlap
-	UFUNCTION()
-		virtual void AgroSphereOnOverlapBegin(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult);
-
-	/// return the enemy to it's main location
-	UFUNCTION()
-		virtual void AgroSphereOnOverlapEnd(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex);
-
-	/// start attacking the player when overlap
-	UFUNCTION()
-		virtual void CombatSphereOnOverlapBegin(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult);
-
-	/// stop attacking the player and if the player still overlaping the AgroSphere keep chasing him
-	UFUNCTION()
-		virtual void CombatSphereOnOverlapEnd(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex);
-
-	/// Move Enemy to the Main player location by its specified location speed
-	UFUNCTION(BlueprintCallable)
-		void MoveToTarget(class AMain* Target);
-
-	UFUNCTION()
-		void CombatOnOverlapBegin(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult);
-
-	UFUNCTION()
-		void CombatOnOverlapEnd(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex);
-
-	/// To call from animation blueprint to enable collision on specific AnimNotify
-	UFUNCTION(BlueprintCallable)
-		void ActivateCollision();
-
-	/// To call from animation blueprint to disable collision on specific AnimNotify
-	UFUNCTION(BlueprintCallable)
-		void DeActivateCollision();
-
-	UFUNCTION(BlueprintCallable)
-		void Attack();
-
-	UFUNCTION(BlueprintCallable)
-		void AttackEnd();
-
-	virtual float TakeDamage(float DamageAmount, struct FDamageEvent const& DamageEvent, class AController* EventInstigator, AActor* DamageCauser) override;
-
-	void Die(AActor* Causer);
-
-	UFUNCTION(BlueprintCallable)
-		void DeathEnd();
-
-	bool Alive();
-
-	void Disappear();
-};
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Character.h"
+#include "EnemySignificanceSubsystem.h"
+#include "Enemy.generated.h"
+
+UENUM(BlueprintType)
+enum class EEnemyMovementStatus:uint8
+{
+	EMS_Idle			UMETA(DisplayName = "Idle"),
+	EMS_MoveToTarget	UMETA(DisplayName = "MoveToTarget"),
+	EMS_Attacking		UMETA(DisplayName = "Attacking"),
+	EMS_Dead			UMETA(DisplayName = "Dead"),
+
+	EMS_MAX				UMETA(DisplayName = "DefaultMax")
+};
+
+UCLASS()
+class MYFIRSTPROJECT_API AEnemy: public ACharacter
+{
+	GENERATED_BODY()
+
+public:
+	// Sets default values for this character's properties
+	AEnemy(const FObjectInitializer& ObjectInitializer);
+
+	/// to set enemy movement status for playing animation
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Movement")
+		EEnemyMovementStatus EnemyMovementStatus;
+
+	/// sphere to let enemy start chasing player on overlap
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "AI")
+		class USphereComponent* AgroSphere;
+
+	/// sphere to let enemy start attacking player on overlap
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "AI")
+		USphereComponent* CombatSphere;
+
+	/// to call moveTo function /// this is a reference to the AI controller
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "AI")
+		class AAIController* AIController;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadWrite, Category = "AI")
+		bool bOverlappingCombatSphere;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadWrite, Category = "AI")
+		AMain* CombatTarget;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AI")
+		float Health;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AI")
+		float MaxHealth;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AI")
+		float Damage;
+
+	/// soft references, streamed in by UAssetPreloadSubsystem while the enemy or a spawner of it is around
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AI")
+		TSoftObjectPtr<class UParticleSystem> HitParticles;
+
+	/// sound to play when hitting
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AI")
+		TSoftObjectPtr<class USoundCue> HitSound;
+
+	/// sound to play when attacking
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AI")
+		TSoftObjectPtr<USoundCue> SwingSound;
+
+	/// Shape swept by MeleeTrace, it never collides itself
+	UPROPERTY(VisibleAnywhere, BlueprintReadWrite, Category = "Combat")
+		class UBoxComponent* CombatCollision;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Combat")
+		class UMeleeTraceComponent* MeleeTrace;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Combat")
+		TSoftObjectPtr<class UAnimMontage> CombatMontage;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Combat")
+		bool bAttacking;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Combat")
+		float AttackMinTime;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Combat")
+		float AttackMaxTime;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Combat")
+		TSubclassOf<UDamageType> DamageTypeClass;
+
+	FTimerHandle DeathTimer;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Combat")
+		float DeathDelay;
+
+	bool bHasValidTarget;
+
+	/// player the enemy is chasing, kept so throttled tiers can re-issue MoveToTarget
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "AI")
+		class AMain* ChaseTarget;
+
+	/// world time of the last MoveTo request
+	float LastMoveToTime;
+
+	/// Far from the player, steer with the shared flow field instead of path finding on its own
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AI")
+		bool bUseFlowField;
+
+	/// Cost settings from the closest to the farthest tier /// tier 0 is the full cost behaviour
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "AI | Significance")
+		TArray<FEnemySignificanceTier> SignificanceTiers;
+
+	/// Tier currently applied, -1 before the first significance update
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "AI | Significance")
+		int32 SignificanceTier;
+
+protected:
+	// Called when the game starts or when spawned
+	virtual void BeginPlay() override;
+
+	/// Called when the actor is destroyed or its level is unloaded
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+public:
+	// Called every frame
+	virtual void Tick(float DeltaTime) override;
+
+	// Called to bind functionality to input
+	virtual void SetupPlayerInputComponent(class UInputComponent* PlayerInputComponent) override;
+
+	UFUNCTION(BlueprintCallable)
+		void SetEnemyMovementStatus(EEnemyMovementStatus Status) { EnemyMovementStatus = Status; }
+
+	FORCEINLINE EEnemyMovementStatus GetEnemyMovementStatus() { return EnemyMovementStatus; }
+
+	/// start chasing the player /// moving toward the player when overlap
+	UFUNCTION()
+		virtual void AgroSphereOnOverlapBegin(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult);
+
+	/// return the enemy to it's main location
+	UFUNCTION()
+		virtual void AgroSphereOnOverlapEnd(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex);
+
+	/// start attacking the player when overlap
+	UFUNCTION()
+		virtual void CombatSphereOnOverlapBegin(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult);
+
+	/// stop attacking the player and if the player still overlaping the AgroSphere keep chasing him
+	UFUNCTION()
+		virtual void CombatSphereOnOverlapEnd(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex);
+
+	/// Move Enemy to the Main player location by its specified location speed
+	UFUNCTION(BlueprintCallable)
+		void MoveToTarget(class AMain* Target);
+
+	/// Damage the player once per swing
+	void OnMeleeHit(const FHitResult& Hit);
+
+	/// To call from animation blueprint to start the swing trace on specific AnimNotify
+	UFUNCTION(BlueprintCallable)
+		void ActivateCollision();
+
+	/// To call from animation blueprint to end the swing trace on specific AnimNotify
+	UFUNCTION(BlueprintCallable)
+		void DeActivateCollision();
+
+	UFUNCTION(BlueprintCallable)
+		void Attack();
+
+	UFUNCTION(BlueprintCallable)
+		void AttackEnd();
+
+	virtual float TakeDamage(float DamageAmount, struct FDamageEvent const& DamageEvent, class AController* EventInstigator, AActor* DamageCauser) override;
+
+	void Die(AActor* Causer);
+
+	/// End of the death montage, leaves a corpse behind and frees the enemy, or freezes it until DeathDelay if corpses are off
+	UFUNCTION(BlueprintCallable)
+		void DeathEnd();
+
+	bool Alive();
+
+	/// Ask the attack scheduler for the next attack, AttackMinTime to AttackMaxTime from now
+	void QueueAttack();
+
+	/// Drop the queued attack and give back the attack token if this enemy holds it
+	void ClearQueuedAttack();
+
+	void Disappear();
+
+	/// Hide the enemy and stop everything it runs so it can wait in the enemy pool
+	void DeactivateForPool();
+
+	/// Bring a pooled enemy back to life with the state of a freshly spawned one
+	void ActivateFromPool();
+
+	/// Restore Health, movement status, collision and animation flags to the class defaults
+	void ResetForReuse();
+
+	/// Set tick intervals, repath mode and AgroSphere overlaps for a significance tier
+	void ApplySignificanceTier(int32 Tier);
+
+	/// Settings of the applied tier, full cost settings if none is applied yet
+	const FEnemySignificanceTier& GetSignificanceSettings() const;
+
+private:
+
+	/// add/remove the enemy from the world managers that track live enemies
+	void RegisterLiveEnemy();
+	void UnregisterLiveEnemy();
+};
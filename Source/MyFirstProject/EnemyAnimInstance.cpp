@@ -1,36 +1,45 @@
-// Fill out your copyright notice in the Description page of Project Settings.
-
-#include "EnemyAnimInstance.h"
-#include "Enemy.h"
-
-void UEnemyAnimInstance::NativeInitializeAnimation()
-{
-	if (Pawn == nullptr)
-	{
-		Pawn = TryGetPawnOwner();
-		if (Pawn)
-		{
-			Enemy = Cast<AEnemy>(Pawn);
-		}
-	}
-}
-
-void UEnemyAnimInstance::UpdateAnimationProperties()
-{
-	if (Pawn == nullptr)
-	{
-		Pawn = TryGetPawnOwner();
-
-		if (Pawn)
-		{
-			Enemy = Cast<AEnemy>(Pawn);
-		}
-	}
-
-	if (Pawn)
-	{
-		FVector Speed = Pawn->GetVelocity();
-		FVector LateralSpeed = FVector(Speed.X, Speed.Y, 0.f);
-		MovementSpeed = LateralSpeed.Size();
-	}
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "EnemyAnimInstance.h"
+#include "Enemy.h"
+
+void FEnemyAnimInstanceProxy::PreUpdate(UAnimInstance* InAnimInstance, float DeltaSeconds)
+{
+	Super::PreUpdate(InAnimInstance, DeltaSeconds);
+
+	UEnemyAnimInstance* AnimInstance = CastChecked<UEnemyAnimInstance>(InAnimInstance);
+
+	if (AnimInstance->Pawn == nullptr)
+	{
+		AnimInstance->Pawn = AnimInstance->TryGetPawnOwner();
+		AnimInstance->Enemy = Cast<AEnemy>(AnimInstance->Pawn);
+	}
+
+	Velocity = AnimInstance->Pawn ? AnimInstance->Pawn->GetVelocity() : FVector::ZeroVector;
+}
+
+void FEnemyAnimInstanceProxy::Update(float DeltaSeconds)
+{
+	Super::Update(DeltaSeconds);
+
+	/// the game thread doesn't touch the instance while its proxy updates
+	UEnemyAnimInstance* AnimInstance = static_cast<UEnemyAnimInstance*>(GetAnimInstanceObject());
+
+	AnimInstance->MovementSpeed = FVector(Velocity.X, Velocity.Y, 0.f).Size();
+}
+
+void UEnemyAnimInstance::NativeInitializeAnimation()
+{
+	if (Pawn == nullptr)
+	{
+		Pawn = TryGetPawnOwner();
+		if (Pawn)
+		{
+			Enemy = Cast<AEnemy>(Pawn);
+		}
+	}
+}
+
+void UEnemyAnimInstance::UpdateAnimationProperties()
+{
 }
\ No newline at end of file
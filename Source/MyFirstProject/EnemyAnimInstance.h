@@ -1,31 +1,68 @@
-// Fill out your copyright notice in the Description page of Project Settings.
-
-#pragma once
-
-#include "CoreMinimal.h"
-#include "Animation/AnimInstance.h"
-#include "EnemyAnimInstance.generated.h"
-
-/**
- *
- */
-UCLASS()
-class MYFIRSTPROJECT_API UEnemyAnimInstance: public UAnimInstance
-{
-	GENERATED_BODY()
-
-public:
-	virtual void NativeInitializeAnimation() override;
-
-	UFUNCTION(BluePrintCallable, Category = AnimationsProperties)
-		void UpdateAnimationProperties();
-
-	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Movement)
-		float MovementSpeed;
-
-	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Movement)
-		class APawn* Pawn;
-
-	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Movement)
-		class AEnemy* Enemy;
-};
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Animation/AnimInstance.h"
+#include "Animation/AnimInstanceProxy.h"
+#include "EnemyAnimInstance.generated.h"
+
+/// Pawn data copied on the game thread, the animation properties are computed from it on a worker thread
+USTRUCT()
+struct FEnemyAnimInstanceProxy: public FAnimInstanceProxy
+{
+	GENERATED_BODY()
+
+	FEnemyAnimInstanceProxy() {}
+
+	FEnemyAnimInstanceProxy(UAnimInstance* InAnimInstance): FAnimInstanceProxy(InAnimInstance) {}
+
+	/// game thread, before the parallel update
+	virtual void PreUpdate(UAnimInstance* InAnimInstance, float DeltaSeconds) override;
+
+	/// worker thread, before the anim graph reads the properties
+	virtual void Update(float DeltaSeconds) override;
+
+private:
+
+	FVector Velocity = FVector::ZeroVector;
+};
+
+/**
+ *
+ */
+UCLASS()
+class MYFIRSTPROJECT_API UEnemyAnimInstance: public UAnimInstance
+{
+	GENERATED_BODY()
+
+	friend struct FEnemyAnimInstanceProxy;
+
+public:
+	virtual void NativeInitializeAnimation() override;
+
+	/// The properties are filled by the native update now, kept for the event graphs that still call it
+	UFUNCTION(BluePrintCallable, Category = AnimationsProperties)
+		void UpdateAnimationProperties();
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Movement)
+		float MovementSpeed;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Movement)
+		class APawn* Pawn;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Movement)
+		class AEnemy* Enemy;
+
+protected:
+
+	virtual FAnimInstanceProxy* CreateAnimInstanceProxy() override { return &Proxy; }
+
+	/// the proxy is a member, nothing to free
+	virtual void DestroyAnimInstanceProxy(FAnimInstanceProxy* InProxy) override {}
+
+private:
+
+	UPROPERTY(Transient)
+		FEnemyAnimInstanceProxy Proxy;
+};
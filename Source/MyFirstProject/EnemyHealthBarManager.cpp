@@ -0,0 +1,224 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "EnemyHealthBarManager.h"
+#include "Blueprint/UserWidget.h"
+#include "Engine/GameViewportClient.h"
+#include "Engine/LocalPlayer.h"
+#include "GameFramework/PlayerController.h"
+#include "SceneView.h"
+#include "Enemy.h"
+#include "EnemyHealthBarWidget.h"
+#include "Main.h"
+#include "SpatialGridSubsystem.h"
+
+UEnemyHealthBarManager::UEnemyHealthBarManager()
+{
+	PrimaryComponentTick.bCanEverTick = true;
+	PrimaryComponentTick.TickGroup = TG_PostUpdateWork; /// after movement and the camera, so bars don't trail a frame behind
+
+	PoolSize = 8;
+	EngageRadius = 2500.f;
+	RefreshInterval = 0.1f;
+	BarSize = FVector2D(300.f, 25.f);
+	BarOffset = 85.f;
+
+	TimeSinceRefresh = 0.f;
+}
+
+void UEnemyHealthBarManager::CreatePool(TSubclassOf<UUserWidget> WidgetClass)
+{
+	APlayerController* PlayerController = Cast<APlayerController>(GetOwner());
+	if (!WidgetClass || !PlayerController || !PlayerController->IsLocalController()) return;
+
+	const bool bPerEnemy = WidgetClass->IsChildOf(UEnemyHealthBarWidget::StaticClass());
+	const int32 Count = bPerEnemy ? PoolSize : 1;
+
+	for (int32 i = 0; i < Count; i++)
+	{
+		UUserWidget* Widget = CreateWidget<UUserWidget>(PlayerController, WidgetClass);
+		if (!Widget) continue;
+
+		Widget->AddToViewport();
+		Widget->SetVisibility(ESlateVisibility::Collapsed);
+		Widget->SetAlignmentInViewport(FVector2D(0.f, 0.f));
+		Widget->SetDesiredSizeInViewport(BarSize); /// fixed size, set once instead of every frame
+
+		FBarSlot Slot;
+		Slot.Widget = Widget;
+		Slot.HealthBarWidget = Cast<UEnemyHealthBarWidget>(Widget);
+
+		Widgets.Add(Widget);
+		Slots.Add(Slot);
+	}
+}
+
+int32 UEnemyHealthBarManager::GetVisibleBarCount() const
+{
+	int32 Count = 0;
+	for (const FBarSlot& Slot : Slots)
+	{
+		if (Slot.bVisible) Count++;
+	}
+	return Count;
+}
+
+void UEnemyHealthBarManager::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+	if (Slots.Num() == 0) return;
+
+	TimeSinceRefresh += DeltaTime;
+	if (TimeSinceRefresh >= RefreshInterval)
+	{
+		TimeSinceRefresh = 0.f;
+		RefreshTargets();
+	}
+
+	UpdateBars();
+}
+
+void UEnemyHealthBarManager::RefreshTargets()
+{
+	APlayerController* PlayerController = Cast<APlayerController>(GetOwner());
+	AMain* Main = PlayerController ? Cast<AMain>(PlayerController->GetPawn()) : nullptr;
+
+	TArray<AActor*> Engaged;
+
+	if (Main && Main->MovementStatus != EMovementStatus::EMS_Dead)
+	{
+		if (!Slots[0].HealthBarWidget) /// plain widget, it can only show the combat target
+		{
+			if (Main->bHasCombatTarget && Main->CombatTarget && Main->CombatTarget->Alive())
+			{
+				Engaged.Add(Main->CombatTarget);
+			}
+		} else if (USpatialGridSubsystem* SpatialGrid = GetWorld()->GetSubsystem<USpatialGridSubsystem>())
+		{
+			SpatialGrid->QueryNearest(Main->GetActorLocation(), EngageRadius, Slots.Num(), SpatialGridMask::Enemy, Engaged, [Main](AActor* Actor)
+			{
+				AEnemy* Enemy = Cast<AEnemy>(Actor);
+				return Enemy && Enemy->Alive() && (Enemy->ChaseTarget == Main || Enemy->CombatTarget == Main || Main->CombatTarget == Enemy);
+			});
+		}
+	}
+
+	/// keep bars on enemies that are still engaged so they don't jump between widgets
+	for (FBarSlot& Slot : Slots)
+	{
+		if (Slot.Enemy.IsValid() && Engaged.Contains(Slot.Enemy.Get()))
+		{
+			Engaged.RemoveSingleSwap(Slot.Enemy.Get());
+		} else
+		{
+			ReleaseSlot(Slot);
+		}
+	}
+
+	int32 SlotIndex = 0;
+	for (AActor* Actor : Engaged)
+	{
+		while (SlotIndex < Slots.Num() && Slots[SlotIndex].Enemy.IsValid())
+		{
+			SlotIndex++;
+		}
+		if (SlotIndex == Slots.Num()) break;
+
+		FBarSlot& Slot = Slots[SlotIndex];
+		Slot.Enemy = Cast<AEnemy>(Actor);
+		Slot.ShownPercent = -1.f;
+		Slot.ShownPosition = FVector2D(-1.f, -1.f);
+
+		if (Slot.HealthBarWidget)
+		{
+			Slot.HealthBarWidget->SetEnemy(Slot.Enemy.Get());
+		}
+	}
+}
+
+void UEnemyHealthBarManager::UpdateBars()
+{
+	bool bAnyAssigned = false;
+	for (const FBarSlot& Slot : Slots)
+	{
+		bAnyAssigned |= Slot.Enemy.IsValid();
+	}
+	if (!bAnyAssigned) return;
+
+	APlayerController* PlayerController = Cast<APlayerController>(GetOwner());
+	ULocalPlayer* LocalPlayer = PlayerController ? PlayerController->GetLocalPlayer() : nullptr;
+	if (!LocalPlayer || !LocalPlayer->ViewportClient) return;
+
+	/// one view projection for all bars instead of a ProjectWorldLocationToScreen per bar
+	FSceneViewProjectionData ProjectionData;
+	if (!LocalPlayer->GetProjectionData(LocalPlayer->ViewportClient->Viewport, eSSP_FULL, ProjectionData)) return;
+
+	const FMatrix ViewProjection = ProjectionData.ComputeViewProjectionMatrix();
+	const FIntRect ViewRect = ProjectionData.GetConstrainedViewRect();
+
+	for (FBarSlot& Slot : Slots)
+	{
+		AEnemy* Enemy = Slot.Enemy.Get();
+		if (!Enemy)
+		{
+			if (Slot.bVisible) ReleaseSlot(Slot);
+			continue;
+		}
+
+		if (!Enemy->Alive() || Enemy->IsHidden())
+		{
+			ReleaseSlot(Slot);
+			continue;
+		}
+
+		FVector2D ScreenPosition;
+		bool bOnScreen = FSceneView::ProjectWorldToScreen(Enemy->GetActorLocation(), ViewRect, ViewProjection, ScreenPosition);
+		bOnScreen = bOnScreen && ScreenPosition.X > ViewRect.Min.X - BarSize.X && ScreenPosition.X < ViewRect.Max.X
+			&& ScreenPosition.Y > ViewRect.Min.Y && ScreenPosition.Y < ViewRect.Max.Y + BarOffset;
+
+		if (!bOnScreen)
+		{
+			SetSlotVisible(Slot, false);
+			continue;
+		}
+
+		ScreenPosition.Y -= BarOffset;
+
+		if (!ScreenPosition.Equals(Slot.ShownPosition, 0.5f))
+		{
+			Slot.Widget->SetPositionInViewport(ScreenPosition);
+			Slot.ShownPosition = ScreenPosition;
+		}
+
+		if (Slot.HealthBarWidget)
+		{
+			const float Percent = Enemy->MaxHealth > 0.f ? Enemy->Health / Enemy->MaxHealth : 0.f;
+			if (!FMath::IsNearlyEqual(Percent, Slot.ShownPercent))
+			{
+				Slot.HealthBarWidget->SetHealthPercent(Percent);
+				Slot.ShownPercent = Percent;
+			}
+		}
+
+		SetSlotVisible(Slot, true);
+	}
+}
+
+void UEnemyHealthBarManager::SetSlotVisible(FBarSlot& Slot, bool bVisible)
+{
+	if (Slot.bVisible == bVisible) return;
+
+	Slot.bVisible = bVisible;
+	Slot.Widget->SetVisibility(bVisible ? ESlateVisibility::HitTestInvisible : ESlateVisibility::Collapsed);
+}
+
+void UEnemyHealthBarManager::ReleaseSlot(FBarSlot& Slot)
+{
+	SetSlotVisible(Slot, false);
+	Slot.Enemy.Reset();
+
+	if (Slot.HealthBarWidget)
+	{
+		Slot.HealthBarWidget->SetEnemy(nullptr);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,81 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "EnemyHealthBarManager.generated.h"
+
+/**
+ * Shows floating health bars over every enemy engaged with the player from a fixed widget pool
+ * All bars are projected with one view projection per frame, hidden and off-screen bars cost nothing
+ * and health is only pushed to a widget when it changed
+ */
+UCLASS(ClassGroup = (Custom), meta = (BlueprintSpawnableComponent))
+class MYFIRSTPROJECT_API UEnemyHealthBarManager: public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+
+	UEnemyHealthBarManager();
+
+	/// Bars that can be on screen at once, the closest engaged enemies get them
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "HUD")
+		int32 PoolSize;
+
+	/// Enemies farther than this never get a bar
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "HUD")
+		float EngageRadius;
+
+	/// Seconds between looking up which enemies are engaged, bar positions update every frame
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "HUD")
+		float RefreshInterval;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "HUD")
+		FVector2D BarSize;
+
+	/// Pixels the bar is drawn above the projected enemy location
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "HUD")
+		float BarOffset;
+
+	/// Create the widgets, a class not derived from UEnemyHealthBarWidget can't be told which enemy it shows so only the combat target gets a bar
+	void CreatePool(TSubclassOf<class UUserWidget> WidgetClass);
+
+	/// Look up the engaged enemies now instead of waiting for the next refresh
+	void RequestRefresh() { TimeSinceRefresh = RefreshInterval; }
+
+	UFUNCTION(BlueprintPure, Category = "HUD")
+		int32 GetVisibleBarCount() const;
+
+	virtual void TickComponent(float DeltaTime, enum ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+
+private:
+
+	struct FBarSlot
+	{
+		UUserWidget* Widget = nullptr;
+		class UEnemyHealthBarWidget* HealthBarWidget = nullptr;
+		TWeakObjectPtr<class AEnemy> Enemy;
+		float ShownPercent = -1.f;
+		FVector2D ShownPosition = FVector2D(-1.f, -1.f);
+		bool bVisible = false;
+	};
+
+	/// assign pooled bars to the currently engaged enemies, closest first
+	void RefreshTargets();
+
+	/// project every assigned bar with a single view projection
+	void UpdateBars();
+
+	void SetSlotVisible(FBarSlot& Slot, bool bVisible);
+
+	void ReleaseSlot(FBarSlot& Slot);
+
+	UPROPERTY()
+		TArray<UUserWidget*> Widgets;
+
+	TArray<FBarSlot> Slots;
+
+	float TimeSinceRefresh;
+};
@@ -0,0 +1,19 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "EnemyHealthBarWidget.h"
+#include "Components/ProgressBar.h"
+
+void UEnemyHealthBarWidget::SetEnemy(AEnemy* NewEnemy)
+{
+	Enemy = NewEnemy;
+}
+
+void UEnemyHealthBarWidget::SetHealthPercent(float Percent)
+{
+	if (HealthBar)
+	{
+		HealthBar->SetPercent(Percent);
+	}
+
+	OnHealthPercentChanged(Percent);
+}
\ No newline at end of file
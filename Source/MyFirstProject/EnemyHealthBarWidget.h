@@ -0,0 +1,34 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Blueprint/UserWidget.h"
+#include "EnemyHealthBarWidget.generated.h"
+
+/**
+ * Floating enemy health bar, the health bar manager pushes the enemy and its health into it instead of the widget polling them
+ */
+UCLASS()
+class MYFIRSTPROJECT_API UEnemyHealthBarWidget: public UUserWidget
+{
+	GENERATED_BODY()
+
+public:
+
+	/// Filled automatically when the widget has a progress bar named HealthBar
+	UPROPERTY(BlueprintReadOnly, Category = "HUD", meta = (BindWidgetOptional))
+		class UProgressBar* HealthBar;
+
+	/// Enemy the bar currently shows
+	UPROPERTY(BlueprintReadOnly, Category = "HUD")
+		class AEnemy* Enemy;
+
+	void SetEnemy(AEnemy* NewEnemy);
+
+	void SetHealthPercent(float Percent);
+
+	/// Called only when the displayed health actually changed
+	UFUNCTION(BlueprintImplementableEvent, Category = "HUD")
+		void OnHealthPercentChanged(float Percent);
+};
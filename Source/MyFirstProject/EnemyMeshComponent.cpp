@@ -0,0 +1,37 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "EnemyMeshComponent.h"
+#include "Engine/World.h"
+#include "AnimationBudgetSubsystem.h"
+
+UEnemyMeshComponent::UEnemyMeshComponent()
+{
+	/// rough guesses until the first ticks are measured
+	FullUpdateMs = 0.1f;
+	SkippedUpdateMs = 0.01f;
+}
+
+void UEnemyMeshComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+	const uint64 StartCycles = FPlatformTime::Cycles64();
+
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+	const float Ms = FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - StartCycles);
+
+	/// the update rate parameters were refreshed at the start of this tick
+	const bool bUpdated = !ShouldUseUpdateRateOptimizations() || !AnimUpdateRateParams || !AnimUpdateRateParams->ShouldSkipUpdate();
+
+	if (bUpdated)
+	{
+		FullUpdateMs = FMath::Lerp(FullUpdateMs, Ms, 0.1f);
+	} else
+	{
+		SkippedUpdateMs = FMath::Lerp(SkippedUpdateMs, Ms, 0.1f);
+	}
+
+	if (UAnimationBudgetSubsystem* Budget = GetWorld()->GetSubsystem<UAnimationBudgetSubsystem>())
+	{
+		Budget->AddTickCost(Ms);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,29 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "EnemyMeshComponent.generated.h"
+
+/**
+ * Enemy skeletal mesh that measures its own tick, so the animation budget knows what a full update and an
+ * interpolated frame cost. Only game thread time is measured, the anim graph update running on workers isn't
+ */
+UCLASS(ClassGroup = (Rendering), meta = (BlueprintSpawnableComponent))
+class MYFIRSTPROJECT_API UEnemyMeshComponent: public USkeletalMeshComponent
+{
+	GENERATED_BODY()
+
+public:
+
+	UEnemyMeshComponent();
+
+	/// Smoothed cost of a tick that updated the animation, in milliseconds
+	float FullUpdateMs;
+
+	/// Smoothed cost of a tick that skipped or interpolated the update, in milliseconds
+	float SkippedUpdateMs;
+
+	virtual void TickComponent(float DeltaTime, enum ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+};
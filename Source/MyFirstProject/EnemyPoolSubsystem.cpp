@@ -0,0 +1,128 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "EnemyPoolSubsystem.h"
+#include "Engine/World.h"
+#include "Enemy.h"
+#include "AIController.h"
+
+static FAutoConsoleCommandWithWorld PoolStatsCommand(
+	TEXT("Pool.Stats"),
+	TEXT("Print enemy pool hit/miss counters"),
+	FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+{
+	if (World)
+	{
+		if (UEnemyPoolSubsystem* Pool = World->GetSubsystem<UEnemyPoolSubsystem>())
+		{
+			Pool->LogStats();
+		}
+	}
+}));
+
+void UEnemyPoolSubsystem::Deinitialize()
+{
+	FreeEnemies.Empty();
+	OwnedEnemies.Empty();
+
+	Super::Deinitialize();
+}
+
+void UEnemyPoolSubsystem::Prewarm(TSubclassOf<AEnemy> EnemyClass, int32 Count, const FVector& Location)
+{
+	if (!EnemyClass) return;
+
+	TArray<TWeakObjectPtr<AEnemy>>& Free = FreeEnemies.FindOrAdd(EnemyClass);
+
+	while (Free.Num() < Count)
+	{
+		AEnemy* Enemy = SpawnEnemy(EnemyClass, Location, FRotator(0.f));
+		if (!Enemy) break;
+
+		Enemy->DeactivateForPool();
+		Free.Add(Enemy);
+		Stats.Prewarmed++;
+	}
+}
+
+AEnemy* UEnemyPoolSubsystem::Acquire(TSubclassOf<AEnemy> EnemyClass, const FVector& Location, const FRotator& Rotation)
+{
+	if (!EnemyClass) return nullptr;
+
+	if (TArray<TWeakObjectPtr<AEnemy>>* Free = FreeEnemies.Find(EnemyClass))
+	{
+		while (Free->Num() > 0)
+		{
+			AEnemy* Enemy = Free->Pop(false).Get();
+
+			if (IsValid(Enemy)) /// instances can be destroyed behind our back (level unload, editor), skip them
+			{
+				Stats.Hits++;
+				Enemy->SetActorLocationAndRotation(Location, Rotation, false, nullptr, ETeleportType::TeleportPhysics);
+				Enemy->ActivateFromPool();
+				return Enemy;
+			}
+		}
+	}
+
+	Stats.Misses++;
+	return SpawnEnemy(EnemyClass, Location, Rotation);
+}
+
+bool UEnemyPoolSubsystem::Release(AEnemy* Enemy)
+{
+	if (!Enemy || !OwnedEnemies.Contains(Enemy)) return false;
+
+	Enemy->DeactivateForPool();
+	FreeEnemies.FindOrAdd(Enemy->GetClass()).Add(Enemy);
+	Stats.Releases++;
+
+	return true;
+}
+
+FEnemyPoolStats UEnemyPoolSubsystem::GetStats() const
+{
+	FEnemyPoolStats Result = Stats;
+
+	for (const auto& Pair : FreeEnemies)
+	{
+		Result.Free += Pair.Value.Num();
+	}
+	Result.Active = OwnedEnemies.Num() - Result.Free;
+
+	return Result;
+}
+
+void UEnemyPoolSubsystem::LogStats() const
+{
+	FEnemyPoolStats Current = GetStats();
+	const int32 Requests = Current.Hits + Current.Misses;
+	const float HitRate = Requests > 0 ? 100.f * Current.Hits / Requests : 0.f;
+
+	UE_LOG(LogTemp, Log, TEXT("EnemyPool: hits %d, misses %d (%.1f%% hit rate), releases %d, prewarmed %d, active %d, free %d"),
+		Current.Hits, Current.Misses, HitRate, Current.Releases, Current.Prewarmed, Current.Active, Current.Free);
+}
+
+AEnemy* UEnemyPoolSubsystem::SpawnEnemy(UClass* EnemyClass, const FVector& Location, const FRotator& Rotation)
+{
+	UWorld* World = GetWorld();
+	if (!World) return nullptr;
+
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
+
+	AEnemy* Enemy = World->SpawnActor<AEnemy>(EnemyClass, Location, Rotation, SpawnParams);
+
+	if (Enemy)
+	{
+		Enemy->SpawnDefaultController();
+
+		AAIController* AICont = Cast<AAIController>(Enemy->GetController());
+		if (AICont)
+		{
+			Enemy->AIController = AICont;
+		}
+
+		OwnedEnemies.Add(Enemy);
+	}
+	return Enemy;
+}
\ No newline at end of file
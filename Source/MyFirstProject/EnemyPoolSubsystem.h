@@ -0,0 +1,82 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "EnemyPoolSubsystem.generated.h"
+
+/// Counters reported by the enemy pool
+USTRUCT(BlueprintType)
+struct FEnemyPoolStats
+{
+	GENERATED_BODY()
+
+	/// Acquire calls served by an already spawned instance
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Pool")
+		int32 Hits = 0;
+
+	/// Acquire calls that had to spawn a new instance
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Pool")
+		int32 Misses = 0;
+
+	/// Dead enemies that were recycled back into the pool
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Pool")
+		int32 Releases = 0;
+
+	/// Instances spawned ahead of time by Prewarm
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Pool")
+		int32 Prewarmed = 0;
+
+	/// Instances currently in use
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Pool")
+		int32 Active = 0;
+
+	/// Instances currently waiting in the pool
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Pool")
+		int32 Free = 0;
+};
+
+/**
+ * Keeps dead enemies around and hands them back out to spawn volumes instead of spawning/destroying actors
+ */
+UCLASS()
+class MYFIRSTPROJECT_API UEnemyPoolSubsystem: public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	virtual void Deinitialize() override;
+
+	/// Make sure at least Count free instances of EnemyClass (with their AI controller) are waiting in the pool
+	UFUNCTION(BlueprintCallable, Category = "Pool")
+		void Prewarm(TSubclassOf<class AEnemy> EnemyClass, int32 Count, const FVector& Location);
+
+	/// Take an enemy out of the pool and place it at Location, spawn a new one if the pool is empty
+	UFUNCTION(BlueprintCallable, Category = "Pool")
+		AEnemy* Acquire(TSubclassOf<AEnemy> EnemyClass, const FVector& Location, const FRotator& Rotation);
+
+	/// Put an enemy back into the pool /// returns false if the enemy isn't owned by the pool and should be destroyed
+	UFUNCTION(BlueprintCallable, Category = "Pool")
+		bool Release(AEnemy* Enemy);
+
+	UFUNCTION(BlueprintPure, Category = "Pool")
+		FEnemyPoolStats GetStats() const;
+
+	void LogStats() const;
+
+private:
+
+	/// spawn a new enemy with its default AI controller, returns nullptr on failure
+	AEnemy* SpawnEnemy(UClass* EnemyClass, const FVector& Location, const FRotator& Rotation);
+
+	/// free instances waiting to be reused, per enemy class
+	TMap<UClass*, TArray<TWeakObjectPtr<AEnemy>>> FreeEnemies;
+
+	/// every instance spawned by the pool, used to tell pooled enemies from placed ones
+	UPROPERTY()
+		TSet<AEnemy*> OwnedEnemies;
+
+	FEnemyPoolStats Stats;
+};
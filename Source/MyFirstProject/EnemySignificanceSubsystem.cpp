@@ -0,0 +1,119 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "EnemySignificanceSubsystem.h"
+#include "Engine/World.h"
+#include "Kismet/GameplayStatics.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "GameFramework/Pawn.h"
+#include "Enemy.h"
+
+static TAutoConsoleVariable<int32> CVarEnemySignificance(
+	TEXT("ai.EnemySignificance"),
+	1,
+	TEXT("0: every enemy runs at full cost, 1: scale enemy cost down with distance and visibility to the player"));
+
+UEnemySignificanceSubsystem::UEnemySignificanceSubsystem()
+{
+	UpdateInterval = 0.2f;
+	NotRenderedGraceTime = 0.5f;
+	TimeUntilUpdate = 0.f;
+}
+
+void UEnemySignificanceSubsystem::Deinitialize()
+{
+	Enemies.Empty();
+
+	Super::Deinitialize();
+}
+
+void UEnemySignificanceSubsystem::Tick(float DeltaTime)
+{
+	TimeUntilUpdate -= DeltaTime;
+
+	if (TimeUntilUpdate <= 0.f)
+	{
+		TimeUntilUpdate = UpdateInterval;
+		UpdateSignificance();
+	}
+}
+
+TStatId UEnemySignificanceSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UEnemySignificanceSubsystem, STATGROUP_Tickables);
+}
+
+void UEnemySignificanceSubsystem::Register(AEnemy* Enemy)
+{
+	if (Enemy)
+	{
+		Enemies.AddUnique(Enemy);
+	}
+}
+
+void UEnemySignificanceSubsystem::Unregister(AEnemy* Enemy)
+{
+	Enemies.RemoveSingleSwap(Enemy, false);
+}
+
+int32 UEnemySignificanceSubsystem::ComputeTier(const AEnemy* Enemy, const FVector& ViewLocation) const
+{
+	const TArray<FEnemySignificanceTier>& Tiers = Enemy->SignificanceTiers;
+
+	/// fighting enemies always behave exactly as before
+	if (Tiers.Num() == 0 || CVarEnemySignificance.GetValueOnGameThread() == 0 || Enemy->bOverlappingCombatSphere || Enemy->bAttacking)
+	{
+		return 0;
+	}
+
+	const float DistanceSquared = FVector::DistSquared(Enemy->GetActorLocation(), ViewLocation);
+
+	int32 Tier = Tiers.Num() - 1;
+	for (int32 i = 0; i < Tiers.Num(); i++)
+	{
+		if (DistanceSquared <= FMath::Square(Tiers[i].MaxDistance))
+		{
+			Tier = i;
+			break;
+		}
+	}
+
+	/// off-screen enemies drop one tier, the closest tier is kept so enemies right behind the player still react
+	if (Tier > 0 && Tier < Tiers.Num() - 1 && !Enemy->GetMesh()->WasRecentlyRendered(NotRenderedGraceTime))
+	{
+		Tier++;
+	}
+
+	return Tier;
+}
+
+void UEnemySignificanceSubsystem::UpdateSignificance()
+{
+	UWorld* World = GetWorld();
+	APawn* Player = UGameplayStatics::GetPlayerPawn(World, 0);
+
+	if (!Player) return;
+
+	const FVector ViewLocation = Player->GetActorLocation();
+	const float Now = World->GetTimeSeconds();
+
+	for (int32 i = Enemies.Num() - 1; i >= 0; i--)
+	{
+		AEnemy* Enemy = Enemies[i].Get();
+
+		if (!Enemy)
+		{
+			Enemies.RemoveAtSwap(i, 1, false);
+			continue;
+		}
+
+		Enemy->ApplySignificanceTier(ComputeTier(Enemy, ViewLocation));
+
+		/// chasing enemies on a throttled tier only get a fresh MoveTo every RepathInterval
+		const float RepathInterval = Enemy->GetSignificanceSettings().RepathInterval;
+
+		if (RepathInterval > 0.f && Enemy->ChaseTarget && Enemy->GetEnemyMovementStatus() == EEnemyMovementStatus::EMS_MoveToTarget && Now - Enemy->LastMoveToTime >= RepathInterval)
+		{
+			Enemy->MoveToTarget(Enemy->ChaseTarget);
+		}
+	}
+}
\ No newline at end of file
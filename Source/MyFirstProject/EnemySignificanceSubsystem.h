@@ -0,0 +1,78 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "TickableGameplaySubsystem.h"
+#include "EnemySignificanceSubsystem.generated.h"
+
+/// What an enemy is allowed to spend at one significance tier
+USTRUCT(BlueprintType)
+struct FEnemySignificanceTier
+{
+	GENERATED_BODY()
+
+	/// Enemies closer to the player than this use the tier
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Significance")
+		float MaxDistance = 0.f;
+
+	/// Tick interval of the CharacterMovementComponent, 0 ticks every frame
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Significance")
+		float MovementTickInterval = 0.f;
+
+	/// Tick interval of the skeletal mesh (animation update), 0 ticks every frame, unused while the animation budget is on
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Significance")
+		float AnimTickInterval = 0.f;
+
+	/// Seconds between MoveToTarget re-issues, 0 follows the goal actor continuously
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Significance")
+		float RepathInterval = 0.f;
+
+	/// Whether the AgroSphere generates overlap events
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Significance")
+		bool bAgroSphereOverlaps = true;
+};
+
+/**
+ * Ranks live enemies by distance and visibility to the player and scales their per-frame work down with it
+ */
+UCLASS()
+class MYFIRSTPROJECT_API UEnemySignificanceSubsystem: public UTickableGameplaySubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	UEnemySignificanceSubsystem();
+
+	/// Seconds between two significance passes over all enemies
+	float UpdateInterval;
+
+	/// Enemies not rendered during this many seconds drop one tier
+	float NotRenderedGraceTime;
+
+	virtual void Deinitialize() override;
+
+	virtual void Tick(float DeltaTime) override;
+
+	virtual TStatId GetStatId() const override;
+
+	void Register(class AEnemy* Enemy);
+
+	void Unregister(AEnemy* Enemy);
+
+	/// Live enemies registered, dead and pooled ones excluded
+	int32 GetNumEnemies() const { return Enemies.Num(); }
+
+	/// Tier index an enemy should use right now, 0 being the most significant
+	int32 ComputeTier(const AEnemy* Enemy, const FVector& ViewLocation) const;
+
+private:
+
+	/// compute tiers and re-issue throttled MoveTo requests
+	void UpdateSignificance();
+
+	TArray<TWeakObjectPtr<AEnemy>> Enemies;
+
+	float TimeUntilUpdate;
+};
@@ -1,47 +1,47 @@
-// Fill out your copyright notice in the Description page of Project Settings.
-
-#include "Explosive.h"
-#include "Main.h"
-#include "Kismet/GamePlayStatics.h"
-#include "Sound/SoundCue.h"
-#include "Engine/World.h"
-#include "Enemy.h"
-
-AExplosive::AExplosive()
-{
-	Damage = 15.f;
-}
-
-void AExplosive::OnOverlapBegin(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult)
-{
-	/// Super is used to call the parent element functionality
-	Super::OnOverlapBegin(OverlappedComponent, OtherActor, OtherComp, OtherBodyIndex, bFromSweep, SweepResult);
-
-	if (OtherActor)
-	{
-		AMain* Main = Cast<AMain>(OtherActor); /// Cast the other actor into Main and save it into the variable
-		AEnemy* Enemy = Cast<AEnemy>(OtherActor); /// Cast the other actor into Main and save it into the variable
-
-		if (Main || Enemy)
-		{
-			if (OverlapParticles)
-			{
-				UGameplayStatics::SpawnEmitterAtLocation(GetWorld(), OverlapParticles, GetActorLocation(), FRotator(0.f), true);
-			}
-
-			if (OverlapSound)
-			{
-				UGameplayStatics::PlaySound2D(this, OverlapSound);
-			}
-
-			UGameplayStatics::ApplyDamage(OtherActor, Damage, nullptr, this, DamageTypeClass);
-
-			Destroy();
-		}
-	}
-}
-
-void AExplosive::OnOverlapEnd(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex)
-{
-	Super::OnOverlapEnd(OverlappedComponent, OtherActor, OtherComp, OtherBodyIndex);
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Explosive.h"
+#include "Main.h"
+#include "Kismet/GamePlayStatics.h"
+#include "Sound/SoundCue.h"
+#include "Engine/World.h"
+#include "Enemy.h"
+
+AExplosive::AExplosive()
+{
+	Damage = 15.f;
+}
+
+void AExplosive::OnOverlapBegin(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult)
+{
+	/// Super is used to call the parent element functionality
+	Super::OnOverlapBegin(OverlappedComponent, OtherActor, OtherComp, OtherBodyIndex, bFromSweep, SweepResult);
+
+	if (OtherActor)
+	{
+		AMain* Main = Cast<AMain>(OtherActor); /// Cast the other actor into Main and save it into the variable
+		AEnemy* Enemy = Cast<AEnemy>(OtherActor); /// Cast the other actor into Main and save it into the variable
+
+		if (Main || Enemy)
+		{
+			if (OverlapParticles)
+			{
+				UGameplayStatics::SpawnEmitterAtLocation(GetWorld(), OverlapParticles, GetActorLocation(), FRotator(0.f), true);
+			}
+
+			if (OverlapSound)
+			{
+				UGameplayStatics::PlaySound2D(this, OverlapSound);
+			}
+
+			UGameplayStatics::ApplyDamage(OtherActor, Damage, nullptr, this, DamageTypeClass);
+
+			Destroy();
+		}
+	}
+}
+
+void AExplosive::OnOverlapEnd(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex)
+{
+	Super::OnOverlapEnd(OverlappedComponent, OtherActor, OtherComp, OtherBodyIndex);
 }
\ No newline at end of file
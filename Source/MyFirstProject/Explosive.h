@@ -1,32 +1,32 @@
-// Fill out your copyright notice in the Description page of Project Settings.
-
-#pragma once
-
-#include "CoreMinimal.h"
-#include "Item.h"
-#include "Explosive.generated.h"
-
-/**
- *
- */
-UCLASS()
-class MYFIRSTPROJECT_API AExplosive: public AItem
-{
-	GENERATED_BODY()
-
-public:
-
-	AExplosive();
-
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Damage")
-		float Damage;
-
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Combat")
-		TSubclassOf<UDamageType> DamageTypeClass;
-
-	/// Important: UFUNCTION macros will be inherited from the parent class
-
-	virtual void OnOverlapBegin(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult) override;
-
-	virtual void OnOverlapEnd(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex) override;
-};
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Item.h"
+#include "Explosive.generated.h"
+
+/**
+ *
+ */
+UCLASS()
+class MYFIRSTPROJECT_API AExplosive: public AItem
+{
+	GENERATED_BODY()
+
+public:
+
+	AExplosive();
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Damage")
+		float Damage;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Combat")
+		TSubclassOf<UDamageType> DamageTypeClass;
+
+	/// Important: UFUNCTION macros will be inherited from the parent class
+
+	virtual void OnOverlapBegin(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult) override;
+
+	virtual void OnOverlapEnd(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex) override;
+};
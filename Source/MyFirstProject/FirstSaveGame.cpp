@@ -1,11 +1,11 @@
-// Fill out your copyright notice in the Description page of Project Settings.
-
-#include "FirstSaveGame.h"
-
-UFirstSaveGame::UFirstSaveGame()
-{
-	PlayerName = TEXT("Default");
-	UserIndex = 0;
-
-	CharacterStats.WeaponName = TEXT("");
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "FirstSaveGame.h"
+
+UFirstSaveGame::UFirstSaveGame()
+{
+	PlayerName = TEXT("Default");
+	UserIndex = 0;
+
+	CharacterStats.WeaponName = TEXT("");
 }
\ No newline at end of file
@@ -1,58 +1,72 @@
-// Fill out your copyright notice in the Description page of Project Settings.
-
-#pragma once
-
-#include "CoreMinimal.h"
-#include "GameFramework/SaveGame.h"
-#include "FirstSaveGame.generated.h"
-
-USTRUCT(BlueprintType)
-struct FCharacterStats
-{
-	GENERATED_BODY()
-
-		UPROPERTY(VisibleAnywhere, Category = "SaveGameData")
-		float Health;
-
-	UPROPERTY(VisibleAnywhere, Category = "SaveGameData")
-		float MaxHealth;
-
-	UPROPERTY(VisibleAnywhere, Category = "SaveGameData")
-		float Stamina;
-
-	UPROPERTY(VisibleAnywhere, Category = "SaveGameData")
-		float MaxStamina;
-
-	UPROPERTY(VisibleAnywhere, Category = "SaveGameData")
-		int32 Coins;
-
-	UPROPERTY(VisibleAnywhere, Category = "SaveGameData")
-		FVector Location;
-
-	UPROPERTY(VisibleAnywhere, Category = "SaveGameData")
-		FRotator Rotation;
-
-	UPROPERTY(VisibleAnywhere, Category = "SaveGameData")
-		FString WeaponName;
-};
-/**
- *
- */
-UCLASS()
-class MYFIRSTPROJECT_API UFirstSaveGame: public USaveGame
-{
-	GENERATED_BODY()
-
-public:
-
-	UFirstSaveGame();
-
-	UPROPERTY(VisibleAnywhere, Category = Basic)
-		FString PlayerName;
-
-	UPROPERTY(VisibleAnywhere, Category = Basic)
-		uint32 UserIndex;
-
-	UPROPERTY(VisibleAnywhere, Category = Basic)
-		FCharacterStats CharacterStats;
-};
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/SaveGame.h"
+#include "FirstSaveGame.generated.h"
+
+USTRUCT(BlueprintType)
+struct FCharacterStats
+{
+	GENERATED_BODY()
+
+		UPROPERTY(VisibleAnywhere, Category = "SaveGameData")
+		float Health;
+
+	UPROPERTY(VisibleAnywhere, Category = "SaveGameData")
+		float MaxHealth;
+
+	UPROPERTY(VisibleAnywhere, Category = "SaveGameData")
+		float Stamina;
+
+	UPROPERTY(VisibleAnywhere, Category = "SaveGameData")
+		float MaxStamina;
+
+	UPROPERTY(VisibleAnywhere, Category = "SaveGameData")
+		int32 Coins;
+
+	UPROPERTY(VisibleAnywhere, Category = "SaveGameData")
+		FVector Location;
+
+	UPROPERTY(VisibleAnywhere, Category = "SaveGameData")
+		FRotator Rotation;
+
+	UPROPERTY(VisibleAnywhere, Category = "SaveGameData")
+		FString WeaponName;
+
+	/// Plain binary serialization, doesn't touch any UObject so it can run on a worker thread
+	friend FArchive& operator<<(FArchive& Ar, FCharacterStats& Stats)
+	{
+		Ar << Stats.Health;
+		Ar << Stats.MaxHealth;
+		Ar << Stats.Stamina;
+		Ar << Stats.MaxStamina;
+		Ar << Stats.Coins;
+		Ar << Stats.Location;
+		Ar << Stats.Rotation;
+		Ar << Stats.WeaponName;
+		return Ar;
+	}
+};
+/**
+ *
+ */
+UCLASS()
+class MYFIRSTPROJECT_API UFirstSaveGame: public USaveGame
+{
+	GENERATED_BODY()
+
+public:
+
+	UFirstSaveGame();
+
+	UPROPERTY(VisibleAnywhere, Category = Basic)
+		FString PlayerName;
+
+	UPROPERTY(VisibleAnywhere, Category = Basic)
+		uint32 UserIndex;
+
+	UPROPERTY(VisibleAnywhere, Category = Basic)
+		FCharacterStats CharacterStats;
+};
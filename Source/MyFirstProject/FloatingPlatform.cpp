@@ -1,69 +1,64 @@
-// Fill out your copyright notice in the Description page of Project Settings.
-
-#include "FloatingPlatform.h"
-#include "Components/StaticMeshComponent.h"
-#include "TimerManager.h"
-
-// Sets default values
-AFloatingPlatform::AFloatingPlatform()
-{
-	// Set this actor to call Tick() every frame.  You can turn this off to improve performance if you don't need it.
-	PrimaryActorTick.bCanEverTick = true;
-
-	Mesh = CreateDefaultSubobject<UStaticMeshComponent>(TEXT("Mesh"));
-	RootComponent = Mesh;
-
-	StartPoint = FVector(0.f);
-	EndPoint = FVector(0.f);
-	bInterping = false;
-	InterpSpeed = 4.0f;
-	InterpTime = 1.f;
-}
-
-// Called when the game starts or when spawned
-void AFloatingPlatform::BeginPlay()
-{
-	Super::BeginPlay();
-
-	StartPoint = GetActorLocation();
-	EndPoint += StartPoint;
-	bInterping = false;
-
-	GetWorldTimerManager().SetTimer(InterpTimer, this, &AFloatingPlatform::ToggleInterping, InterpTime);
-
-	Distance = (EndPoint - StartPoint).Size(); /// Get float value of distance to travel
-}
-
-// Called every frame
-void AFloatingPlatform::Tick(float DeltaTime)
-{
-	Super::Tick(DeltaTime);
-
-	if (bInterping)
-	{
-		FVector CurrentLocation = GetActorLocation();
-		FVector Interp = FMath::VInterpTo(CurrentLocation, EndPoint, DeltaTime, InterpSpeed); /// set new location vector eachtime a frame is passed
-		SetActorLocation(Interp); /// move smoothly from  CurrentLocation to EndPoint at specific InterpSpeed
-
-		float DistanceTraveled = (GetActorLocation() - StartPoint).Size();
-
-		if (Distance - DistanceTraveled <= 1.f)
-		{
-			ToggleInterping(); /// Stop Interping if CurrentLocation and EndPoint are near eachother
-			GetWorldTimerManager().SetTimer(InterpTimer, this, &AFloatingPlatform::ToggleInterping, InterpTime);
-			SwapVectors(StartPoint, EndPoint); /// Swap etart and end point to reverse actor direction
-		}
-	}
-}
-
-void AFloatingPlatform::ToggleInterping()
-{
-	bInterping = !bInterping;
-}
-
-void AFloatingPlatform::SwapVectors(FVector& Vec1, FVector& Vec2)
-{
-	FVector Temp = Vec1;
-	Vec1 = Vec2;
-	Vec2 = Temp;
-}
\ No newline at end of file
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "FloatingPlatform.h"
+#include "Components/StaticMeshComponent.h"
+#include "Engine/World.h"
+#include "PlatformMoverSubsystem.h"
+#include "TickGovernanceSubsystem.h"
+
+// Sets default values
+AFloatingPlatform::AFloatingPlatform()
+{
+	// Set this actor to call Tick() every frame.  You can turn this off to improve performance if you don't need it.
+	PrimaryActorTick.bCanEverTick = true;
+	PrimaryActorTick.bStartWithTickEnabled = false; /// UPlatformMoverSubsystem moves it, only a Blueprint Event Tick needs this
+
+	Mesh = CreateDefaultSubobject<UStaticMeshComponent>(TEXT("Mesh"));
+	RootComponent = Mesh;
+
+	StartPoint = FVector(0.f);
+	EndPoint = FVector(0.f);
+	bInterping = false;
+	InterpSpeed = 4.0f;
+	InterpTime = 1.f;
+}
+
+// Called when the game starts or when spawned
+void AFloatingPlatform::BeginPlay()
+{
+	Super::BeginPlay();
+
+	StartPoint = GetActorLocation();
+	EndPoint += StartPoint;
+	bInterping = false;
+	SetActorTickEnabled(UTickGovernanceSubsystem::HasBlueprintTick(this));
+
+	/// rest InterpTime at each end, then ease over with the continuous form of VInterpTo
+	FPlatformMotion Motion;
+	Motion.Init(StartPoint, EndPoint, InterpSpeed, InterpTime, GetWorld()->GetTimeSeconds());
+
+	if (UPlatformMoverSubsystem* PlatformMover = GetWorld()->GetSubsystem<UPlatformMoverSubsystem>())
+	{
+		PlatformMover->Register(this, Motion);
+	}
+}
+
+void AFloatingPlatform::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UPlatformMoverSubsystem* PlatformMover = GetWorld()->GetSubsystem<UPlatformMoverSubsystem>())
+	{
+		PlatformMover->Unregister(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
+FVector AFloatingPlatform::GetLocationAtTime(float Time) const
+{
+	FVector Location = GetActorLocation();
+	if (UPlatformMoverSubsystem* PlatformMover = GetWorld()->GetSubsystem<UPlatformMoverSubsystem>())
+	{
+		PlatformMover->SamplePlatform(this, Time, Location);
+	}
+	return Location;
+}
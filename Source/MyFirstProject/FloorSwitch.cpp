@@ -1,89 +1,152 @@
-// Fill out your copyright notice in the Description page of Project Settings.
-
-#include "FloorSwitch.h"
-#include "Components/BoxComponent.h"
-#include "Components/StaticMeshComponent.h"
-#include "Components/PrimitiveComponent.h"
-#include "TimerManager.h"
-
-// Sets default values
-AFloorSwitch::AFloorSwitch()
-{
-	// Set this actor to call Tick() every frame.  You can turn this off to improve performance if you don't need it.
-	PrimaryActorTick.bCanEverTick = true;
-
-	TriggerBox = CreateDefaultSubobject<UBoxComponent>(TEXT("TriggerBox"));
-	RootComponent = TriggerBox;
-
-	TriggerBox->SetCollisionEnabled(ECollisionEnabled::QueryOnly); /// Enable collision only for overlap
-	TriggerBox->SetCollisionObjectType(ECollisionChannel::ECC_WorldStatic); /// Collide only with WorldStatic Objects
-	TriggerBox->SetCollisionResponseToAllChannels(ECollisionResponse::ECR_Ignore); /// Do not fire any event when overlapped with anything
-	TriggerBox->SetCollisionResponseToChannel(ECollisionChannel::ECC_Pawn, ECollisionResponse::ECR_Overlap); /// Enable overlap collision on pawn because our character is derived from pawn
-	TriggerBox->SetBoxExtent(FVector(62.f, 62.f, 32.f));
-
-	FloorSwitch = CreateDefaultSubobject<UStaticMeshComponent>(TEXT("FloorSwitch"));
-	FloorSwitch->SetupAttachment(GetRootComponent());
-
-	Door = CreateDefaultSubobject<UStaticMeshComponent>(TEXT("Door"));
-	Door->SetupAttachment(GetRootComponent());
-
-	SwitchTime = 2.0f;
-
-	bCharacterOnSwitch = false;
-}
-
-// Called when the game starts or when spawned
-void AFloorSwitch::BeginPlay()
-{
-	Super::BeginPlay();
-
-	TriggerBox->OnComponentBeginOverlap.AddDynamic(this, &AFloorSwitch::OnOverlapBegin); /// Delegate OnComponentBeginOverlap with OnOverlapBegin
-	TriggerBox->OnComponentEndOverlap.AddDynamic(this, &AFloorSwitch::OnOverlapEnd); /// Delegate OnComponentEndOverlap with OnOverlapEnd
-
-	InitialDoorLocation = Door->GetComponentLocation();
-	InitialSwitchLocation = FloorSwitch->GetComponentLocation();
-}
-
-// Called every frame
-void AFloorSwitch::Tick(float DeltaTime)
-{
-	Super::Tick(DeltaTime);
-}
-
-void AFloorSwitch::OnOverlapBegin(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult)
-{
-	if (!bCharacterOnSwitch) bCharacterOnSwitch = true; /// Set switch state to be pressed No*1
-
-	RaiseDoor();
-	LowerFloorSwitch();
-}
-
-void AFloorSwitch::OnOverlapEnd(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex)
-{
-	if (bCharacterOnSwitch) bCharacterOnSwitch = false; /// Set switch state to be unpressed No*1
-
-	GetWorldTimerManager().SetTimer(SwitchHandle, this, &AFloorSwitch::CloseDoor, SwitchTime); /// Wait specific time to lower the door so it will not close directly No*1
-}
-
-void AFloorSwitch::UpdateDoorLocation(float Z)
-{
-	FVector NewLocation = InitialDoorLocation;
-	NewLocation.Z += Z;
-	Door->SetWorldLocation(NewLocation);
-}
-
-void AFloorSwitch::UpdateFloorSwitchLocation(float Z)
-{
-	FVector NewLocation = InitialSwitchLocation;
-	NewLocation.Z += Z;
-	FloorSwitch->SetWorldLocation(NewLocation);
-}
-
-void AFloorSwitch::CloseDoor()
-{
-	if (!bCharacterOnSwitch) /// this will prevent direct door lowering if the user step out of the switch No*1
-	{
-		LowerDoor();
-		RaiseFloorSwitch();
-	}
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "FloorSwitch.h"
+#include "Components/BoxComponent.h"
+#include "Components/StaticMeshComponent.h"
+#include "Components/PrimitiveComponent.h"
+#include "Curves/CurveFloat.h"
+#include "TimerManager.h"
+#include "TickGovernanceSubsystem.h"
+
+// Sets default values
+AFloorSwitch::AFloorSwitch()
+{
+	// Set this actor to call Tick() every frame.  You can turn this off to improve performance if you don't need it.
+	PrimaryActorTick.bCanEverTick = true;
+	PrimaryActorTick.bStartWithTickEnabled = false; /// ticks only while the door is moving
+
+	TriggerBox = CreateDefaultSubobject<UBoxComponent>(TEXT("TriggerBox"));
+	RootComponent = TriggerBox;
+
+	TriggerBox->SetCollisionEnabled(ECollisionEnabled::QueryOnly); /// Enable collision only for overlap
+	TriggerBox->SetCollisionObjectType(ECollisionChannel::ECC_WorldStatic); /// Collide only with WorldStatic Objects
+	TriggerBox->SetCollisionResponseToAllChannels(ECollisionResponse::ECR_Ignore); /// Do not fire any event when overlapped with anything
+	TriggerBox->SetCollisionResponseToChannel(ECollisionChannel::ECC_Pawn, ECollisionResponse::ECR_Overlap); /// Enable overlap collision on pawn because our character is derived from pawn
+	TriggerBox->SetBoxExtent(FVector(62.f, 62.f, 32.f));
+
+	FloorSwitch = CreateDefaultSubobject<UStaticMeshComponent>(TEXT("FloorSwitch"));
+	FloorSwitch->SetupAttachment(GetRootComponent());
+
+	Door = CreateDefaultSubobject<UStaticMeshComponent>(TEXT("Door"));
+	Door->SetupAttachment(GetRootComponent());
+
+	SwitchTime = 2.0f;
+
+	bCharacterOnSwitch = false;
+
+	bNativeAnimation = true;
+	TransitionTime = 0.75f;
+	DoorRaiseHeight = 450.f;
+	SwitchLowerDepth = 10.f;
+	DoorCurve = nullptr;
+	SwitchCurve = nullptr;
+
+	OpenAlpha = 0.f;
+	OpenDirection = 0.f;
+}
+
+// Called when the game starts or when spawned
+void AFloorSwitch::BeginPlay()
+{
+	Super::BeginPlay();
+
+	TriggerBox->OnComponentBeginOverlap.AddDynamic(this, &AFloorSwitch::OnOverlapBegin); /// Delegate OnComponentBeginOverlap with OnOverlapBegin
+	TriggerBox->OnComponentEndOverlap.AddDynamic(this, &AFloorSwitch::OnOverlapEnd); /// Delegate OnComponentEndOverlap with OnOverlapEnd
+
+	InitialDoorLocation = Door->GetComponentLocation();
+	InitialSwitchLocation = FloorSwitch->GetComponentLocation();
+
+	SetActorTickEnabled(UTickGovernanceSubsystem::HasBlueprintTick(this));
+}
+
+// Called every frame
+void AFloorSwitch::Tick(float DeltaTime)
+{
+	FTickCostScope TickCost(this);
+
+	Super::Tick(DeltaTime);
+
+	if (OpenDirection == 0.f) return;
+
+	OpenAlpha += OpenDirection * DeltaTime / FMath::Max(TransitionTime, KINDA_SMALL_NUMBER);
+	if (OpenAlpha <= 0.f || OpenAlpha >= 1.f)
+	{
+		OpenAlpha = FMath::Clamp(OpenAlpha, 0.f, 1.f);
+		OpenDirection = 0.f;
+		SetActorTickEnabled(UTickGovernanceSubsystem::HasBlueprintTick(this)); /// at rest, sleep until the switch is used again
+	}
+
+	ApplyOpenAlpha();
+}
+
+void AFloorSwitch::OnOverlapBegin(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult)
+{
+	if (!bCharacterOnSwitch) bCharacterOnSwitch = true; /// Set switch state to be pressed No*1
+
+	if (bNativeAnimation)
+	{
+		SetDoorOpen(true);
+	} else
+	{
+		RaiseDoor();
+		LowerFloorSwitch();
+	}
+}
+
+void AFloorSwitch::OnOverlapEnd(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex)
+{
+	if (bCharacterOnSwitch) bCharacterOnSwitch = false; /// Set switch state to be unpressed No*1
+
+	GetWorldTimerManager().SetTimer(SwitchHandle, this, &AFloorSwitch::CloseDoor, SwitchTime); /// Wait specific time to lower the door so it will not close directly No*1
+}
+
+void AFloorSwitch::UpdateDoorLocation(float Z)
+{
+	FVector NewLocation = InitialDoorLocation;
+	NewLocation.Z += Z;
+	Door->SetWorldLocation(NewLocation);
+}
+
+void AFloorSwitch::UpdateFloorSwitchLocation(float Z)
+{
+	FVector NewLocation = InitialSwitchLocation;
+	NewLocation.Z += Z;
+	FloorSwitch->SetWorldLocation(NewLocation);
+}
+
+void AFloorSwitch::CloseDoor()
+{
+	if (!bCharacterOnSwitch) /// this will prevent direct door lowering if the user step out of the switch No*1
+	{
+		if (bNativeAnimation)
+		{
+			SetDoorOpen(false);
+		} else
+		{
+			LowerDoor();
+			RaiseFloorSwitch();
+		}
+	}
+}
+
+void AFloorSwitch::SetDoorOpen(bool bOpen)
+{
+	const float Target = bOpen ? 1.f : 0.f;
+	if (OpenAlpha == Target)
+	{
+		OpenDirection = 0.f;
+		return;
+	}
+
+	OpenDirection = bOpen ? 1.f : -1.f; /// a door already moving just turns around from where it is
+	SetActorTickEnabled(true);
+}
+
+void AFloorSwitch::ApplyOpenAlpha()
+{
+	const float DoorAlpha = DoorCurve ? DoorCurve->GetFloatValue(OpenAlpha) : FMath::SmoothStep(0.f, 1.f, OpenAlpha);
+	const float SwitchAlpha = SwitchCurve ? SwitchCurve->GetFloatValue(OpenAlpha) : FMath::SmoothStep(0.f, 1.f, OpenAlpha);
+
+	UpdateDoorLocation(DoorAlpha * DoorRaiseHeight);
+	UpdateFloorSwitchLocation(-SwitchAlpha * SwitchLowerDepth);
 }
\ No newline at end of file
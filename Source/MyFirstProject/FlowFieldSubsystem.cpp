@@ -0,0 +1,375 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "FlowFieldSubsystem.h"
+#include "Engine/World.h"
+#include "NavigationSystem.h"
+#include "NavigationData.h"
+#include "AIController.h"
+#include "Kismet/GameplayStatics.h"
+#include "GameFramework/Pawn.h"
+#include "Enemy.h"
+#include "Main.h"
+
+static TAutoConsoleVariable<int32> CVarFlowField(
+	TEXT("ai.FlowField"),
+	1,
+	TEXT("0: every chasing enemy path finds to the player, 1: enemies far from the player steer with the shared flow field"));
+
+static FAutoConsoleCommandWithWorld FlowFieldStatsCommand(
+	TEXT("FlowField.Stats"),
+	TEXT("Print the flow field size, build cost and follower count"),
+	FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+{
+	if (World)
+	{
+		if (UFlowFieldSubsystem* FlowField = World->GetSubsystem<UFlowFieldSubsystem>())
+		{
+			FlowField->LogStats();
+		}
+	}
+}));
+
+/// the 8 neighbours of a cell, the diagonals last
+static const FIntPoint NeighbourOffsets[] = { {1, 0}, {-1, 0}, {0, 1}, {0, -1}, {1, 1}, {1, -1}, {-1, 1}, {-1, -1} };
+
+static const float DiagonalCost = 1.41421356f;
+
+UFlowFieldSubsystem::UFlowFieldSubsystem()
+{
+	CellSize = 100.f;
+	HalfExtent = 40;
+	MaxStepHeight = 45.f;
+	DirectChaseRadius = 600.f;
+	MaxCellsPerFrame = 1500;
+
+	bBuilding = false;
+	bHasReadyField = false;
+	bNavigationChanged = false;
+
+	LastRequestTime = -BIG_NUMBER;
+
+	BuildCount = 0;
+	BuildingMs = 0.f;
+	LastBuildMs = 0.f;
+}
+
+void UFlowFieldSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	if (UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(&InWorld))
+	{
+		NavSys->OnNavigationGenerationFinishedDelegate.AddDynamic(this, &UFlowFieldSubsystem::OnNavigationRebuilt);
+	}
+}
+
+void UFlowFieldSubsystem::Deinitialize()
+{
+	Followers.Empty();
+	Waiting.Empty();
+	NavHeights.Empty();
+	Open.Empty();
+
+	Super::Deinitialize();
+}
+
+bool UFlowFieldSubsystem::IsTickable() const
+{
+	return Super::IsTickable() && (Followers.Num() > 0 || bBuilding || GetWorld()->GetTimeSeconds() - LastRequestTime < 2.f);
+}
+
+void UFlowFieldSubsystem::Tick(float DeltaTime)
+{
+	APawn* Player = UGameplayStatics::GetPlayerPawn(GetWorld(), 0);
+
+	if (Player && CVarFlowField.GetValueOnGameThread() != 0)
+	{
+		const FVector PlayerLocation = Player->GetActorLocation();
+
+		/// a field is never thrown away half built, a player moving every frame would otherwise never get one
+		if (!bBuilding && (!bHasReadyField || bNavigationChanged || ToCell(PlayerLocation) != Ready.Goal))
+		{
+			BeginBuild(PlayerLocation);
+		}
+		if (bBuilding)
+		{
+			ContinueBuild();
+		}
+	}
+
+	UpdateFollowers();
+}
+
+FIntPoint UFlowFieldSubsystem::ToCell(const FVector& Location) const
+{
+	return FIntPoint(FMath::FloorToInt(Location.X / CellSize), FMath::FloorToInt(Location.Y / CellSize));
+}
+
+bool UFlowFieldSubsystem::FindCellHeight(const FIntPoint& Cell, float ReferenceZ, float& OutHeight)
+{
+	if (const float* Cached = NavHeights.Find(Cell))
+	{
+		OutHeight = *Cached;
+		return OutHeight != MAX_flt;
+	}
+
+	UNavigationSystemV1* NavSys = FNavigationSystem::GetCurrent<UNavigationSystemV1>(GetWorld());
+	if (!NavSys) return false;
+
+	/// one floor per cell, fine for the castle levels, stacked walkways would need a layer per cell
+	const FVector Center((Cell.X + 0.5f) * CellSize, (Cell.Y + 0.5f) * CellSize, ReferenceZ);
+	const FVector Extent(CellSize * 0.5f, CellSize * 0.5f, MaxStepHeight * 4.f);
+
+	FNavLocation NavLocation;
+	const bool bOnNavmesh = NavSys->ProjectPointToNavigation(Center, NavLocation, Extent);
+
+	OutHeight = bOnNavmesh ? NavLocation.Location.Z : MAX_flt;
+
+	if (NavHeights.Num() >= 1 << 18) /// a very large level, start over rather than grow forever
+	{
+		NavHeights.Reset();
+	}
+	NavHeights.Add(Cell, OutHeight);
+
+	return bOnNavmesh;
+}
+
+void UFlowFieldSubsystem::BeginBuild(const FVector& GoalLocation)
+{
+	if (bNavigationChanged)
+	{
+		NavHeights.Reset();
+		bNavigationChanged = false;
+	}
+
+	const FIntPoint Goal = ToCell(GoalLocation);
+
+	float GoalHeight;
+	if (!FindCellHeight(Goal, GoalLocation.Z, GoalHeight)) return; /// player off the navmesh (jumping, falling), try again next frame
+
+	const int32 Width = GetWidth();
+
+	Building.Goal = Goal;
+	Building.Origin = Goal - FIntPoint(HalfExtent, HalfExtent);
+	Building.Distance.Init(MAX_flt, Width * Width);
+	Building.Height.SetNumUninitialized(Width * Width);
+
+	const int32 GoalIndex = HalfExtent * Width + HalfExtent;
+	Building.Distance[GoalIndex] = 0.f;
+	Building.Height[GoalIndex] = GoalHeight;
+
+	Open.Reset();
+	Open.HeapPush({ 0.f, GoalIndex });
+
+	BuildingMs = 0.f;
+	bBuilding = true;
+}
+
+void UFlowFieldSubsystem::ContinueBuild()
+{
+	const double StartTime = FPlatformTime::Seconds();
+	const int32 Width = GetWidth();
+
+	for (int32 Settled = 0; Settled < MaxCellsPerFrame && Open.Num() > 0; Settled++)
+	{
+		FOpenCell Current;
+		Open.HeapPop(Current, false);
+
+		if (Current.Distance > Building.Distance[Current.Index]) continue; /// reached again through a shorter way since
+
+		const FIntPoint Local(Current.Index % Width, Current.Index / Width);
+		const float CurrentHeight = Building.Height[Current.Index];
+
+		bool bWalkable[4] = { false, false, false, false }; /// orthogonal neighbours, a diagonal step may not cut their corner
+
+		for (int32 i = 0; i < UE_ARRAY_COUNT(NeighbourOffsets); i++)
+		{
+			const FIntPoint Next = Local + NeighbourOffsets[i];
+			if (Next.X < 0 || Next.Y < 0 || Next.X >= Width || Next.Y >= Width) continue;
+
+			const bool bDiagonal = i >= 4;
+			if (bDiagonal && !(bWalkable[NeighbourOffsets[i].X > 0 ? 0 : 1] && bWalkable[NeighbourOffsets[i].Y > 0 ? 2 : 3])) continue;
+
+			float NextHeight;
+			if (!FindCellHeight(Building.Origin + Next, CurrentHeight, NextHeight) || FMath::Abs(NextHeight - CurrentHeight) > MaxStepHeight) continue;
+
+			if (!bDiagonal)
+			{
+				bWalkable[i] = true;
+			}
+
+			const int32 NextIndex = Next.Y * Width + Next.X;
+			const float NextDistance = Current.Distance + (bDiagonal ? DiagonalCost : 1.f);
+
+			if (NextDistance < Building.Distance[NextIndex])
+			{
+				Building.Distance[NextIndex] = NextDistance;
+				Building.Height[NextIndex] = NextHeight;
+				Open.HeapPush({ NextDistance, NextIndex });
+			}
+		}
+	}
+
+	BuildingMs += (FPlatformTime::Seconds() - StartTime) * 1000.0;
+
+	if (Open.Num() == 0)
+	{
+		Swap(Ready, Building);
+		bHasReadyField = true;
+		bBuilding = false;
+
+		BuildCount++;
+		LastBuildMs = BuildingMs;
+
+		for (const TWeakObjectPtr<AEnemy>& WeakEnemy : Waiting)
+		{
+			AEnemy* Enemy = WeakEnemy.Get();
+
+			if (Enemy && Enemy->ChaseTarget && Enemy->Alive() && Enemy->GetEnemyMovementStatus() == EEnemyMovementStatus::EMS_MoveToTarget)
+			{
+				Enemy->MoveToTarget(Enemy->ChaseTarget); /// comes back through StartFollowing
+			}
+		}
+		Waiting.Reset();
+	}
+}
+
+bool UFlowFieldSubsystem::SampleDirection(const FVector& Location, FVector& OutDirection) const
+{
+	if (!bHasReadyField) return false;
+
+	const int32 Width = GetWidth();
+	const FIntPoint Local = ToCell(Location) - Ready.Origin;
+
+	if (Local.X < 0 || Local.Y < 0 || Local.X >= Width || Local.Y >= Width) return false;
+
+	const float Distance = Ready.Distance[Local.Y * Width + Local.X];
+	if (Distance == MAX_flt || Distance == 0.f) return false;
+
+	/// head for the center of the neighbour closest to the player
+	float BestDistance = Distance;
+	FIntPoint Best = Local;
+
+	bool bReachable[4] = { false, false, false, false };
+
+	for (int32 i = 0; i < UE_ARRAY_COUNT(NeighbourOffsets); i++)
+	{
+		const FIntPoint Next = Local + NeighbourOffsets[i];
+		if (Next.X < 0 || Next.Y < 0 || Next.X >= Width || Next.Y >= Width) continue;
+
+		const float NextDistance = Ready.Distance[Next.Y * Width + Next.X];
+
+		if (i < 4)
+		{
+			bReachable[i] = NextDistance != MAX_flt;
+		} else if (!(bReachable[NeighbourOffsets[i].X > 0 ? 0 : 1] && bReachable[NeighbourOffsets[i].Y > 0 ? 2 : 3]))
+		{
+			continue; /// same corner rule as the build
+		}
+
+		if (NextDistance < BestDistance)
+		{
+			BestDistance = NextDistance;
+			Best = Next;
+		}
+	}
+
+	if (Best == Local) return false;
+
+	const FVector Target((Ready.Origin.X + Best.X + 0.5f) * CellSize, (Ready.Origin.Y + Best.Y + 0.5f) * CellSize, Location.Z);
+	OutDirection = (Target - Location).GetSafeNormal2D();
+
+	return !OutDirection.IsZero();
+}
+
+bool UFlowFieldSubsystem::StartFollowing(AEnemy* Enemy)
+{
+	if (!Enemy || !Enemy->ChaseTarget || !Enemy->bUseFlowField || CVarFlowField.GetValueOnGameThread() == 0) return false;
+
+	LastRequestTime = GetWorld()->GetTimeSeconds(); /// keeps the field tracking the player even if this enemy can't use it yet
+
+	if (Followers.Contains(Enemy)) return true;
+
+	if (FVector::DistSquared(Enemy->GetActorLocation(), Enemy->ChaseTarget->GetActorLocation()) <= FMath::Square(DirectChaseRadius)) return false;
+
+	FVector Direction;
+	if (!SampleDirection(Enemy->GetActorLocation(), Direction))
+	{
+		if (!bHasReadyField)
+		{
+			Waiting.AddUnique(Enemy);
+		}
+		return false;
+	}
+
+	Followers.Add(Enemy);
+
+	if (Enemy->AIController)
+	{
+		Enemy->AIController->StopMovement(); /// drop the path it may be following
+	}
+	return true;
+}
+
+void UFlowFieldSubsystem::UpdateFollowers()
+{
+	const bool bEnabled = CVarFlowField.GetValueOnGameThread() != 0;
+
+	for (int32 i = Followers.Num() - 1; i >= 0; i--)
+	{
+		AEnemy* Enemy = Followers[i].Get();
+
+		if (!Enemy)
+		{
+			Followers.RemoveAtSwap(i, 1, false);
+			continue;
+		}
+
+		AMain* Target = Enemy->ChaseTarget;
+		const bool bChasing = Target && Enemy->Alive() && Enemy->GetEnemyMovementStatus() == EEnemyMovementStatus::EMS_MoveToTarget;
+
+		FVector Direction;
+		const bool bSteer = bChasing && bEnabled
+			&& FVector::DistSquared(Enemy->GetActorLocation(), Target->GetActorLocation()) > FMath::Square(DirectChaseRadius)
+			&& SampleDirection(Enemy->GetActorLocation(), Direction);
+
+		if (bSteer)
+		{
+			Enemy->AddMovementInput(Direction);
+
+			if (Enemy->AIController)
+			{
+				Enemy->AIController->SetFocalPoint(Enemy->GetActorLocation() + Direction * CellSize, EAIFocusPriority::Move);
+			}
+			continue;
+		}
+
+		Followers.RemoveAtSwap(i, 1, false);
+
+		if (Enemy->AIController)
+		{
+			Enemy->AIController->ClearFocus(EAIFocusPriority::Move);
+		}
+		if (bChasing) /// close to the player or off the field, path find the rest of the way
+		{
+			Enemy->MoveToTarget(Target);
+		}
+	}
+}
+
+void UFlowFieldSubsystem::OnNavigationRebuilt(ANavigationData* NavData)
+{
+	bNavigationChanged = true;
+}
+
+void UFlowFieldSubsystem::LogStats() const
+{
+	int32 Reachable = 0;
+	for (float Distance : Ready.Distance)
+	{
+		if (Distance != MAX_flt) Reachable++;
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("Flow field: %dx%d cells of %.0f, %d reachable, %d builds, last build %.2fms, %s, %d cached cell heights, %d followers"),
+		GetWidth(), GetWidth(), CellSize, Reachable, BuildCount, LastBuildMs, bBuilding ? TEXT("rebuilding") : TEXT("idle"), NavHeights.Num(), Followers.Num());
+}
\ No newline at end of file
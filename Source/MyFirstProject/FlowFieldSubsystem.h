@@ -0,0 +1,130 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "TickableGameplaySubsystem.h"
+#include "FlowFieldSubsystem.generated.h"
+
+/**
+ * One distance field around the player on the navmesh that every chasing enemy steers down, instead of each enemy
+ * finding and following its own path to the same target. The field is rebuilt over a few frames whenever the player
+ * enters another cell, the previous field keeps steering the enemies meanwhile. Navmesh heights are cached per cell
+ * so a rebuild only projects the cells it hasn't seen before. Enemies close to the player go back to their own
+ * pathfinding, the field is too coarse to approach a target precisely
+ */
+UCLASS()
+class MYFIRSTPROJECT_API UFlowFieldSubsystem: public UTickableGameplaySubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	UFlowFieldSubsystem();
+
+	/// Size of a field cell
+	float CellSize;
+
+	/// Cells from the player to the border of the field
+	int32 HalfExtent;
+
+	/// Highest step between two neighbouring cells an enemy can walk
+	float MaxStepHeight;
+
+	/// Enemies closer than this to the player path find on their own
+	float DirectChaseRadius;
+
+	/// Cells settled per frame while a field is being rebuilt
+	int32 MaxCellsPerFrame;
+
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+
+	virtual void Deinitialize() override;
+
+	virtual void Tick(float DeltaTime) override;
+
+	virtual bool IsTickable() const override;
+
+	/// Steer the enemy with the field until it stops chasing, false if it should path find instead
+	bool StartFollowing(class AEnemy* Enemy);
+
+	/// Direction toward the player at the location, false outside the field or on the player's own cell
+	bool SampleDirection(const FVector& Location, FVector& OutDirection) const;
+
+	void LogStats() const;
+
+private:
+
+	struct FField
+	{
+		/// lowest cell of the square window
+		FIntPoint Origin = FIntPoint::ZeroValue;
+
+		/// cell the distances are measured to
+		FIntPoint Goal = FIntPoint::ZeroValue;
+
+		/// distance to the goal in cells, MAX_flt if unreachable
+		TArray<float> Distance;
+
+		/// navmesh height of each cell
+		TArray<float> Height;
+	};
+
+	struct FOpenCell
+	{
+		float Distance;
+		int32 Index;
+
+		bool operator<(const FOpenCell& Other) const { return Distance < Other.Distance; }
+	};
+
+	int32 GetWidth() const { return HalfExtent * 2 + 1; }
+
+	FIntPoint ToCell(const FVector& Location) const;
+
+	/// navmesh height at the cell center, searched near ReferenceZ, false if the cell is off the navmesh
+	bool FindCellHeight(const FIntPoint& Cell, float ReferenceZ, float& OutHeight);
+
+	void BeginBuild(const FVector& GoalLocation);
+
+	/// settle up to MaxCellsPerFrame cells, swap the fields once the open list runs out
+	void ContinueBuild();
+
+	/// steer every follower, hand back the ones that stopped chasing or left the field
+	void UpdateFollowers();
+
+	UFUNCTION()
+		void OnNavigationRebuilt(class ANavigationData* NavData);
+
+	/// field the enemies steer with
+	FField Ready;
+
+	/// field being rebuilt around the player's new cell
+	FField Building;
+
+	TArray<FOpenCell> Open;
+
+	bool bBuilding;
+
+	bool bHasReadyField;
+
+	/// the navmesh changed, rebuild even if the player stayed in the same cell
+	bool bNavigationChanged;
+
+	/// navmesh height of every cell projected so far, MAX_flt for cells off the navmesh
+	TMap<FIntPoint, float> NavHeights;
+
+	TArray<TWeakObjectPtr<AEnemy>> Followers;
+
+	/// chasers that asked before the first field was ready, a goal actor move never asks again so they are handed over once it is
+	TArray<TWeakObjectPtr<AEnemy>> Waiting;
+
+	/// world time a field was last asked for, the field stops tracking the player when nobody uses it
+	float LastRequestTime;
+
+	int32 BuildCount;
+
+	/// game thread time spent on the field being built and on the last finished one, over all its frames
+	float BuildingMs;
+	float LastBuildMs;
+};
@@ -0,0 +1,40 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "GameplayPerf.h"
+
+DEFINE_STAT(STAT_UpdateCombatTarget);
+DEFINE_STAT(STAT_EnemyOverlaps);
+DEFINE_STAT(STAT_WeaponOverlaps);
+DEFINE_STAT(STAT_MeleeHits);
+DEFINE_STAT(STAT_SpawnOurActor);
+DEFINE_STAT(STAT_SaveGame);
+DEFINE_STAT(STAT_LoadGame);
+DEFINE_STAT(STAT_PlayerControllerTick);
+
+DEFINE_STAT(STAT_LiveEnemies);
+DEFINE_STAT(STAT_OverlapsPerFrame);
+DEFINE_STAT(STAT_SpawnsPerSecond);
+
+CSV_DEFINE_CATEGORY_MODULE(MYFIRSTPROJECT_API, MyFirstProject, true);
+
+uint64 FGameplayPerfCounters::SectionCycles[(int32)EGameplayPerfSection::MAX] = {};
+uint32 FGameplayPerfCounters::Overlaps = 0;
+uint32 FGameplayPerfCounters::Spawns = 0;
+
+const TCHAR* FGameplayPerfCounters::GetSectionName(EGameplayPerfSection Section)
+{
+	static const TCHAR* Names[] =
+	{
+		TEXT("UpdateCombatTarget"),
+		TEXT("Enemy overlaps"),
+		TEXT("Weapon overlaps"),
+		TEXT("Melee hits"),
+		TEXT("SpawnOurActor"),
+		TEXT("SaveGame"),
+		TEXT("LoadGame"),
+		TEXT("PlayerController Tick"),
+	};
+	static_assert(UE_ARRAY_COUNT(Names) == (int32)EGameplayPerfSection::MAX, "one name per section");
+
+	return Names[(int32)Section];
+}
\ No newline at end of file
@@ -0,0 +1,82 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Stats/Stats.h"
+#include "ProfilingDebugging/CsvProfiler.h"
+
+DECLARE_STATS_GROUP(TEXT("MyFirstProject"), STATGROUP_MyFirstProject, STATCAT_Advanced);
+
+DECLARE_CYCLE_STAT_EXTERN(TEXT("UpdateCombatTarget"), STAT_UpdateCombatTarget, STATGROUP_MyFirstProject, MYFIRSTPROJECT_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Enemy overlaps"), STAT_EnemyOverlaps, STATGROUP_MyFirstProject, MYFIRSTPROJECT_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Weapon overlaps"), STAT_WeaponOverlaps, STATGROUP_MyFirstProject, MYFIRSTPROJECT_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Melee hits"), STAT_MeleeHits, STATGROUP_MyFirstProject, MYFIRSTPROJECT_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("SpawnOurActor"), STAT_SpawnOurActor, STATGROUP_MyFirstProject, MYFIRSTPROJECT_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("SaveGame"), STAT_SaveGame, STATGROUP_MyFirstProject, MYFIRSTPROJECT_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("LoadGame"), STAT_LoadGame, STATGROUP_MyFirstProject, MYFIRSTPROJECT_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("PlayerController Tick"), STAT_PlayerControllerTick, STATGROUP_MyFirstProject, MYFIRSTPROJECT_API);
+
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Live enemies"), STAT_LiveEnemies, STATGROUP_MyFirstProject, MYFIRSTPROJECT_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Overlaps per frame"), STAT_OverlapsPerFrame, STATGROUP_MyFirstProject, MYFIRSTPROJECT_API);
+DECLARE_FLOAT_COUNTER_STAT_EXTERN(TEXT("Spawns per second"), STAT_SpawnsPerSecond, STATGROUP_MyFirstProject, MYFIRSTPROJECT_API);
+
+CSV_DECLARE_CATEGORY_MODULE_EXTERN(MYFIRSTPROJECT_API, MyFirstProject);
+
+/// Hot paths timed in every build for the perf overlay, stats and (by default) the CSV profiler compile out of shipping
+enum class EGameplayPerfSection: uint8
+{
+	UpdateCombatTarget,
+	EnemyOverlaps,
+	WeaponOverlaps,
+	MeleeHits,
+	SpawnOurActor,
+	SaveGame,
+	LoadGame,
+	PlayerControllerTick,
+
+	MAX
+};
+
+/// Game thread counters gathered during a frame, read and cleared by the perf overlay subsystem
+struct MYFIRSTPROJECT_API FGameplayPerfCounters
+{
+	static uint64 SectionCycles[(int32)EGameplayPerfSection::MAX];
+
+	static uint32 Overlaps;
+
+	static uint32 Spawns;
+
+	static const TCHAR* GetSectionName(EGameplayPerfSection Section);
+};
+
+struct FGameplayPerfScope
+{
+	explicit FGameplayPerfScope(EGameplayPerfSection InSection)
+		: Section(InSection)
+		, StartCycles(FPlatformTime::Cycles64())
+	{
+	}
+
+	~FGameplayPerfScope()
+	{
+		FGameplayPerfCounters::SectionCycles[(int32)Section] += FPlatformTime::Cycles64() - StartCycles;
+	}
+
+private:
+
+	EGameplayPerfSection Section;
+	uint64 StartCycles;
+};
+
+/// Time the rest of the scope for stat MyFirstProject, the CSV profile and the perf overlay, game thread only
+#define GAMEPLAY_PERF_SCOPE(Section) \
+	SCOPE_CYCLE_COUNTER(STAT_##Section); \
+	CSV_SCOPED_TIMING_STAT(MyFirstProject, Section); \
+	FGameplayPerfScope GameplayPerfScope(EGameplayPerfSection::Section)
+
+/// Count an overlap event for the overlaps per frame counter
+#define GAMEPLAY_PERF_COUNT_OVERLAP() FGameplayPerfCounters::Overlaps++
+
+/// Count an actor spawned by a spawn volume for the spawns per second counter
+#define GAMEPLAY_PERF_COUNT_SPAWN() FGameplayPerfCounters::Spawns++
@@ -1,54 +1,63 @@
-// Fill out your copyright notice in the Description page of Project Settings.
-
-#pragma once
-
-#include "CoreMinimal.h"
-#include "GameFramework/Actor.h"
-#include "Item.generated.h"
-
-UCLASS()
-class MYFIRSTPROJECT_API AItem: public AActor
-{
-	GENERATED_BODY()
-
-public:
-	// Sets default values for this actor's properties
-	AItem();
-
-	/// Base shape collision
-	UPROPERTY(VisibleAnywhere, BlueprintReadWrite, Category = "Item | Collision")
-		class USphereComponent* CollisionVolume;
-
-	/// Base Mesh Component
-	UPROPERTY(VisibleAnywhere, BlueprintReadWrite, Category = "Item | Mesh")
-		class UStaticMeshComponent* Mesh;
-
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Item | Particles")
-		class UParticleSystemComponent* IdleParticlesComponent;
-
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Item | Particles")
-		class UParticleSystem* OverlapParticles;
-
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Item | Sounds")
-		class USoundCue* OverlapSound;
-
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Item | Rotations")
-		bool bRotate;
-
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Item | Rotations")
-		float RotationRate;
-
-protected:
-	// Called when the game starts or when spawned
-	virtual void BeginPlay() override;
-
-public:
-	// Called every frame
-	virtual void Tick(float DeltaTime) override;
-
-	UFUNCTION()
-		virtual void OnOverlapBegin(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult);
-
-	UFUNCTION()
-		virtual void OnOverlapEnd(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex);
-};
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "Item.generated.h"
+
+UCLASS()
+class MYFIRSTPROJECT_API AItem: public AActor
+{
+	GENERATED_BODY()
+
+public:
+	// Sets default values for this actor's properties
+	AItem();
+
+	/// Base shape collision
+	UPROPERTY(VisibleAnywhere, BlueprintReadWrite, Category = "Item | Collision")
+		class USphereComponent* CollisionVolume;
+
+	/// Base Mesh Component
+	UPROPERTY(VisibleAnywhere, BlueprintReadWrite, Category = "Item | Mesh")
+		class UStaticMeshComponent* Mesh;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Item | Particles")
+		class UParticleSystemComponent* IdleParticlesComponent;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Item | Particles")
+		class UParticleSystem* OverlapParticles;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Item | Sounds")
+		class USoundCue* OverlapSound;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Item | Rotations")
+		bool bRotate;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Item | Rotations")
+		float RotationRate;
+
+protected:
+	// Called when the game starts or when spawned
+	virtual void BeginPlay() override;
+
+	/// Called when the actor is destroyed or its level is unloaded
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+public:
+	// Called every frame
+	virtual void Tick(float DeltaTime) override;
+
+	/// Start or stop the idle rotation, call after changing bRotate
+	void UpdateIdleRotation();
+
+	/// Component the idle rotation spins
+	virtual USceneComponent* GetVisualComponent() const;
+
+	UFUNCTION()
+		virtual void OnOverlapBegin(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult);
+
+	UFUNCTION()
+		virtual void OnOverlapEnd(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex);
+};
@@ -0,0 +1,86 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "ItemRotatorSubsystem.h"
+#include "Components/SceneComponent.h"
+#include "Engine/World.h"
+#include "Item.h"
+
+UItemRotatorSubsystem::UItemRotatorSubsystem()
+{
+	bSkipNotRendered = true;
+}
+
+void UItemRotatorSubsystem::Deinitialize()
+{
+	Items.Empty();
+
+	Super::Deinitialize();
+}
+
+bool UItemRotatorSubsystem::IsTickable() const
+{
+	return Items.Num() > 0 && Super::IsTickable();
+}
+
+void UItemRotatorSubsystem::Register(AItem* Item)
+{
+	USceneComponent* Visual = Item ? Item->GetVisualComponent() : nullptr;
+	if (!Visual) return;
+
+	for (const FRotatingItem& Entry : Items)
+	{
+		if (Entry.Item == Item) return;
+	}
+
+	FRotatingItem Entry;
+	Entry.Item = Item;
+	Entry.Visual = Visual;
+	Entry.BaseRotation = Visual->GetRelativeRotation().Quaternion();
+	Entry.RotationRate = Item->RotationRate;
+	Entry.StartTime = GetWorld()->GetTimeSeconds();
+
+	Items.Add(Entry);
+}
+
+void UItemRotatorSubsystem::Unregister(AItem* Item)
+{
+	for (int32 i = 0; i < Items.Num(); i++)
+	{
+		if (Items[i].Item == Item)
+		{
+			if (USceneComponent* Visual = Items[i].Visual.Get())
+			{
+				Visual->SetRelativeRotation(Items[i].BaseRotation);
+			}
+
+			Items.RemoveAtSwap(i);
+			return;
+		}
+	}
+}
+
+void UItemRotatorSubsystem::Tick(float DeltaTime)
+{
+	const float Time = GetWorld()->GetTimeSeconds();
+
+	for (int32 i = Items.Num() - 1; i >= 0; i--)
+	{
+		FRotatingItem& Entry = Items[i];
+
+		AItem* Item = Entry.Item.Get();
+		USceneComponent* Visual = Entry.Visual.Get();
+		if (!Item || !Visual)
+		{
+			Items.RemoveAtSwap(i);
+			continue;
+		}
+
+		if (bSkipNotRendered && !Item->WasRecentlyRendered(0.2f)) continue;
+
+		/// closed form from the start time, no accumulated error and nothing to catch up after skipped frames
+		const float Yaw = FMath::Fmod(Entry.RotationRate * (Time - Entry.StartTime), 360.f);
+		const FQuat Spin(FVector::UpVector, FMath::DegreesToRadians(Yaw));
+
+		Visual->SetRelativeRotation(Spin * Entry.BaseRotation, false, nullptr, ETeleportType::TeleportPhysics);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,50 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "TickableGameplaySubsystem.h"
+#include "ItemRotatorSubsystem.generated.h"
+
+/**
+ * Spins the visual component of every rotating AItem in one loop instead of a tick per item
+ * Only the mesh moves, the item's collision volume stays put so no overlaps are re-evaluated
+ */
+UCLASS()
+class MYFIRSTPROJECT_API UItemRotatorSubsystem: public UTickableGameplaySubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	UItemRotatorSubsystem();
+
+	/// Skip items nobody saw recently, their yaw is a function of time so they're right again when they come into view
+	bool bSkipNotRendered;
+
+	virtual void Deinitialize() override;
+
+	virtual void Tick(float DeltaTime) override;
+
+	virtual bool IsTickable() const override;
+
+	void Register(class AItem* Item);
+
+	/// Stop rotating Item and put its visual component back to its original rotation
+	void Unregister(AItem* Item);
+
+	FORCEINLINE int32 Num() const { return Items.Num(); }
+
+private:
+
+	struct FRotatingItem
+	{
+		TWeakObjectPtr<AItem> Item;
+		TWeakObjectPtr<USceneComponent> Visual;
+		FQuat BaseRotation;
+		float RotationRate;
+		float StartTime;
+	};
+
+	TArray<FRotatingItem> Items;
+};
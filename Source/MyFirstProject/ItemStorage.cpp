@@ -1,17 +1,17 @@
-// Fill out your copyright notice in the Description page of Project Settings.
-
-#include "ItemStorage.h"
-#include "Weapon.h"
-
-// Sets default values
-AItemStorage::AItemStorage()
-{
-	// Set this actor to call Tick() every frame.  You can turn this off to improve performance if you don't need it.
-	PrimaryActorTick.bCanEverTick = false;
-}
-
-// Called when the game starts or when spawned
-void AItemStorage::BeginPlay()
-{
-	Super::BeginPlay();
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "ItemStorage.h"
+#include "Weapon.h"
+
+// Sets default values
+AItemStorage::AItemStorage()
+{
+	// Set this actor to call Tick() every frame.  You can turn this off to improve performance if you don't need it.
+	PrimaryActorTick.bCanEverTick = false;
+}
+
+// Called when the game starts or when spawned
+void AItemStorage::BeginPlay()
+{
+	Super::BeginPlay();
 }
\ No newline at end of file
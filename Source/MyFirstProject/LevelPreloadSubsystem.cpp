@@ -0,0 +1,129 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "LevelPreloadSubsystem.h"
+#include "Engine/World.h"
+#include "Kismet/GameplayStatics.h"
+#include "Misc/PackageName.h"
+#include "AssetRegistryModule.h"
+
+void ULevelPreloadSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	PostLoadMapHandle = FCoreUObjectDelegates::PostLoadMapWithWorld.AddUObject(this, &ULevelPreloadSubsystem::OnPostLoadMap);
+}
+
+void ULevelPreloadSubsystem::Deinitialize()
+{
+	FCoreUObjectDelegates::PostLoadMapWithWorld.Remove(PostLoadMapHandle);
+	Preloads.Empty();
+
+	Super::Deinitialize();
+}
+
+void ULevelPreloadSubsystem::RequestPreload(FName LevelName)
+{
+	if (LevelName.IsNone() || Preloads.Contains(LevelName)) return;
+
+	UWorld* World = GetWorld();
+	if (World && FName(*UGameplayStatics::GetCurrentLevelName(World)) == LevelName) return; /// already in it
+
+	FLevelPreloadInfo& Info = Preloads.Add(LevelName);
+	Info.StartTime = FPlatformTime::Seconds();
+
+	FString PackageName;
+	if (!ResolvePackageName(LevelName, PackageName))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("LevelPreload: no map package found for %s"), *LevelName.ToString());
+		Info.State = ELevelPreloadState::ELPS_Failed;
+		return;
+	}
+
+	Info.PackageName = FName(*PackageName);
+	Info.State = ELevelPreloadState::ELPS_Loading;
+
+	LoadPackageAsync(PackageName, FLoadPackageAsyncDelegate::CreateUObject(this, &ULevelPreloadSubsystem::OnPackageLoaded));
+}
+
+ELevelPreloadState ULevelPreloadSubsystem::GetPreloadState(FName LevelName) const
+{
+	const FLevelPreloadInfo* Info = Preloads.Find(LevelName);
+	return Info ? Info->State : ELevelPreloadState::ELPS_None;
+}
+
+float ULevelPreloadSubsystem::GetPreloadSeconds(FName LevelName) const
+{
+	const FLevelPreloadInfo* Info = Preloads.Find(LevelName);
+	return Info ? Info->LoadSeconds : 0.f;
+}
+
+void ULevelPreloadSubsystem::OpenLevel(UObject* WorldContextObject, FName LevelName)
+{
+	const FLevelPreloadInfo* Info = Preloads.Find(LevelName);
+
+	if (Info && Info->State == ELevelPreloadState::ELPS_Ready)
+	{
+		UE_LOG(LogTemp, Log, TEXT("LevelPreload: opening preloaded %s (loaded in background in %.2fs)"), *LevelName.ToString(), Info->LoadSeconds);
+
+		/// LoadMap finds the package already in memory and skips the disk load
+		UGameplayStatics::OpenLevel(WorldContextObject, Info->PackageName);
+		return;
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("LevelPreload: %s isn't preloaded (%s), falling back to a blocking load"), *LevelName.ToString(),
+		Info && Info->State == ELevelPreloadState::ELPS_Loading ? TEXT("still loading") : TEXT("not requested"));
+
+	UGameplayStatics::OpenLevel(WorldContextObject, LevelName);
+}
+
+void ULevelPreloadSubsystem::OnPackageLoaded(const FName& PackageName, UPackage* LoadedPackage, EAsyncLoadingResult::Type Result)
+{
+	for (auto& Pair : Preloads)
+	{
+		FLevelPreloadInfo& Info = Pair.Value;
+
+		if (Info.PackageName != PackageName || Info.State != ELevelPreloadState::ELPS_Loading) continue;
+
+		Info.LoadSeconds = FPlatformTime::Seconds() - Info.StartTime;
+		Info.World = LoadedPackage && Result == EAsyncLoadingResult::Succeeded ? UWorld::FindWorldInPackage(LoadedPackage) : nullptr;
+		Info.State = Info.World ? ELevelPreloadState::ELPS_Ready : ELevelPreloadState::ELPS_Failed;
+
+		UE_LOG(LogTemp, Log, TEXT("LevelPreload: %s %s in %.2fs"), *Pair.Key.ToString(),
+			Info.State == ELevelPreloadState::ELPS_Ready ? TEXT("ready") : TEXT("failed"), Info.LoadSeconds);
+	}
+}
+
+void ULevelPreloadSubsystem::OnPostLoadMap(UWorld* LoadedWorld)
+{
+	Preloads.Empty();
+}
+
+bool ULevelPreloadSubsystem::ResolvePackageName(FName LevelName, FString& OutPackageName)
+{
+	/// answered from the asset registry in memory, searching the content folders would stall the overlap that asks for the preload
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+	const FString Name = LevelName.ToString();
+
+	if (FPackageName::IsValidLongPackageName(Name))
+	{
+		TArray<FAssetData> Assets;
+		AssetRegistry.GetAssetsByPackageName(LevelName, Assets);
+
+		OutPackageName = Name;
+		return Assets.Num() > 0;
+	}
+
+	/// short names like "Forge" are what OpenLevel accepts, find the map they refer to
+	TArray<FAssetData> Maps;
+	AssetRegistry.GetAssetsByClass(UWorld::StaticClass()->GetFName(), Maps);
+
+	for (const FAssetData& Map : Maps)
+	{
+		if (Map.AssetName == LevelName)
+		{
+			OutPackageName = Map.PackageName.ToString();
+			return true;
+		}
+	}
+	return false;
+}
\ No newline at end of file
@@ -0,0 +1,87 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "UObject/UObjectGlobals.h"
+#include "LevelPreloadSubsystem.generated.h"
+
+/// Where a level package is in the preload pipeline
+UENUM(BlueprintType)
+enum class ELevelPreloadState: uint8
+{
+	ELPS_None		UMETA(DisplayName = "None"),
+	ELPS_Loading	UMETA(DisplayName = "Loading"),
+	ELPS_Ready		UMETA(DisplayName = "Ready"),
+	ELPS_Failed		UMETA(DisplayName = "Failed"),
+
+	ELPS_MAX		UMETA(DisplayName = "DefaultMax")
+};
+
+USTRUCT(BlueprintType)
+struct FLevelPreloadInfo
+{
+	GENERATED_BODY()
+
+	/// Long package name of the map, e.g. /Game/Maps/Forge
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Preload")
+		FName PackageName;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Preload")
+		ELevelPreloadState State = ELevelPreloadState::ELPS_None;
+
+	/// Seconds the async load took, 0 while loading
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Preload")
+		float LoadSeconds = 0.f;
+
+	/// keeps the loaded map in memory until OpenLevel uses it
+	UPROPERTY()
+		UWorld* World = nullptr;
+
+	double StartTime = 0.0;
+};
+
+/**
+ * Loads destination maps in the background so opening them later doesn't stall on disk
+ */
+UCLASS()
+class MYFIRSTPROJECT_API ULevelPreloadSubsystem: public UGameInstanceSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+
+	virtual void Deinitialize() override;
+
+	/// Start loading the package of LevelName in the background, does nothing if it's already loading or loaded
+	UFUNCTION(BlueprintCallable, Category = "Preload")
+		void RequestPreload(FName LevelName);
+
+	UFUNCTION(BlueprintPure, Category = "Preload")
+		ELevelPreloadState GetPreloadState(FName LevelName) const;
+
+	/// Seconds the preload of LevelName took, 0 if it isn't finished
+	UFUNCTION(BlueprintPure, Category = "Preload")
+		float GetPreloadSeconds(FName LevelName) const;
+
+	/// Open LevelName, instant if it was preloaded, a regular blocking load otherwise
+	void OpenLevel(UObject* WorldContextObject, FName LevelName);
+
+private:
+
+	void OnPackageLoaded(const FName& PackageName, UPackage* LoadedPackage, EAsyncLoadingResult::Type Result);
+
+	/// the new map is running, drop the references we held for it
+	void OnPostLoadMap(UWorld* LoadedWorld);
+
+	/// Map name as used by OpenLevel to long package name
+	static bool ResolvePackageName(FName LevelName, FString& OutPackageName);
+
+	UPROPERTY()
+		TMap<FName, FLevelPreloadInfo> Preloads;
+
+	FDelegateHandle PostLoadMapHandle;
+};
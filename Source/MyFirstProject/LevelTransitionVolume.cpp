@@ -1,50 +1,100 @@
-// Fill out your copyright notice in the Description page of Project Settings.
-
-#include "LevelTransitionVolume.h"
-#include "Components/BoxComponent.h"
-#include "Components/BillBoardComponent.h"
-#include "Main.h"
-#include "Weapon.h"
-#include "TimerManager.h"
-
-// Sets default values
-ALevelTransitionVolume::ALevelTransitionVolume()
-{
-	// Set this actor to call Tick() every frame.  You can turn this off to improve performance if you don't need it.
-	PrimaryActorTick.bCanEverTick = false;
-
-	TransitionVolume = CreateDefaultSubobject<UBoxComponent>(TEXT("TransitionVolume"));
-	RootComponent = TransitionVolume;
-
-	BillBoard = CreateDefaultSubobject<UBillboardComponent>(TEXT("BillBoard"));
-	BillBoard->SetupAttachment(GetRootComponent());
-
-	TransitionLevelName = "Forge";
-}
-
-// Called when the game starts or when spawned
-void ALevelTransitionVolume::BeginPlay()
-{
-	Super::BeginPlay();
-
-	TransitionVolume->OnComponentBeginOverlap.AddDynamic(this, &ALevelTransitionVolume::OnOverlapBegin);
-}
-
-// Called every frame
-void ALevelTransitionVolume::Tick(float DeltaTime)
-{
-	Super::Tick(DeltaTime);
-}
-
-void ALevelTransitionVolume::OnOverlapBegin(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult)
-{
-	if (OtherActor)
-	{
-		AMain* Main = Cast<AMain>(OtherActor);
-		if (OtherActor)
-		{
-			//Main->EquippedWeapon->Destroy();
-			Main->SwitchLevel(TransitionLevelName);
-		}
-	}
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "LevelTransitionVolume.h"
+#include "Components/BoxComponent.h"
+#include "Components/BillBoardComponent.h"
+#include "Components/SphereComponent.h"
+#include "LevelPreloadSubsystem.h"
+#include "Main.h"
+#include "Weapon.h"
+#include "TimerManager.h"
+
+// Sets default values
+ALevelTransitionVolume::ALevelTransitionVolume()
+{
+	// Set this actor to call Tick() every frame.  You can turn this off to improve performance if you don't need it.
+	PrimaryActorTick.bCanEverTick = false;
+
+	TransitionVolume = CreateDefaultSubobject<UBoxComponent>(TEXT("TransitionVolume"));
+	RootComponent = TransitionVolume;
+
+	PreloadVolume = CreateDefaultSubobject<USphereComponent>(TEXT("PreloadVolume"));
+	PreloadVolume->SetupAttachment(GetRootComponent());
+	PreloadVolume->SetCollisionResponseToAllChannels(ECollisionResponse::ECR_Ignore);
+	PreloadVolume->SetCollisionResponseToChannel(ECollisionChannel::ECC_Pawn, ECollisionResponse::ECR_Overlap);
+
+	BillBoard = CreateDefaultSubobject<UBillboardComponent>(TEXT("BillBoard"));
+	BillBoard->SetupAttachment(GetRootComponent());
+
+	TransitionLevelName = "Forge";
+	PreloadRadius = 2000.f;
+	MaxPreloadWait = 2.f;
+
+	TransitioningMain = nullptr;
+	PreloadWaitStart = 0.f;
+}
+
+// Called when the game starts or when spawned
+void ALevelTransitionVolume::BeginPlay()
+{
+	Super::BeginPlay();
+
+	TransitionVolume->OnComponentBeginOverlap.AddDynamic(this, &ALevelTransitionVolume::OnOverlapBegin);
+
+	PreloadVolume->SetSphereRadius(PreloadRadius);
+	PreloadVolume->OnComponentBeginOverlap.AddDynamic(this, &ALevelTransitionVolume::PreloadOnOverlapBegin);
+}
+
+// Called every frame
+void ALevelTransitionVolume::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+}
+
+void ALevelTransitionVolume::OnOverlapBegin(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult)
+{
+	if (OtherActor)
+	{
+		AMain* Main = Cast<AMain>(OtherActor);
+		if (Main && !TransitioningMain)
+		{
+			//Main->EquippedWeapon->Destroy();
+			ULevelPreloadSubsystem* Preload = GetGameInstance()->GetSubsystem<ULevelPreloadSubsystem>();
+
+			if (Preload->GetPreloadState(TransitionLevelName) == ELevelPreloadState::ELPS_Loading && MaxPreloadWait > 0.f)
+			{
+				/// almost there, a short wait beats a blocking load
+				TransitioningMain = Main;
+				PreloadWaitStart = GetWorld()->GetTimeSeconds();
+				GetWorldTimerManager().SetTimer(PreloadWaitTimer, this, &ALevelTransitionVolume::WaitForPreload, 0.05f, true);
+				return;
+			}
+
+			Main->SwitchLevel(TransitionLevelName);
+		}
+	}
+}
+
+void ALevelTransitionVolume::PreloadOnOverlapBegin(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult)
+{
+	if (Cast<AMain>(OtherActor))
+	{
+		GetGameInstance()->GetSubsystem<ULevelPreloadSubsystem>()->RequestPreload(TransitionLevelName);
+	}
+}
+
+void ALevelTransitionVolume::WaitForPreload()
+{
+	ULevelPreloadSubsystem* Preload = GetGameInstance()->GetSubsystem<ULevelPreloadSubsystem>();
+	bool bStillLoading = Preload->GetPreloadState(TransitionLevelName) == ELevelPreloadState::ELPS_Loading;
+
+	if (bStillLoading && GetWorld()->GetTimeSeconds() - PreloadWaitStart < MaxPreloadWait) return;
+
+	GetWorldTimerManager().ClearTimer(PreloadWaitTimer);
+
+	if (TransitioningMain)
+	{
+		TransitioningMain->SwitchLevel(TransitionLevelName);
+	}
+	TransitioningMain = nullptr;
 }
\ No newline at end of file
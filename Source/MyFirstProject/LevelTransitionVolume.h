@@ -1,35 +1,61 @@
-// Fill out your copyright notice in the Description page of Project Settings.
-
-#pragma once
-
-#include "CoreMinimal.h"
-#include "GameFramework/Actor.h"
-#include "LevelTransitionVolume.generated.h"
-
-UCLASS()
-class MYFIRSTPROJECT_API ALevelTransitionVolume: public AActor
-{
-	GENERATED_BODY()
-
-public:
-	// Sets default values for this actor's properties
-	ALevelTransitionVolume();
-	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Transition")
-		class UBoxComponent* TransitionVolume;
-
-	class UBillboardComponent* BillBoard;
-
-	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Transition")
-		FName TransitionLevelName;
-
-protected:
-	// Called when the game starts or when spawned
-	virtual void BeginPlay() override;
-
-public:
-	// Called every frame
-	virtual void Tick(float DeltaTime) override;
-
-	UFUNCTION()
-		virtual void OnOverlapBegin(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult);
-};
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "LevelTransitionVolume.generated.h"
+
+UCLASS()
+class MYFIRSTPROJECT_API ALevelTransitionVolume: public AActor
+{
+	GENERATED_BODY()
+
+public:
+	// Sets default values for this actor's properties
+	ALevelTransitionVolume();
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Transition")
+		class UBoxComponent* TransitionVolume;
+
+	/// Entering this starts loading the destination level in the background
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Transition")
+		class USphereComponent* PreloadVolume;
+
+	class UBillboardComponent* BillBoard;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Transition")
+		FName TransitionLevelName;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Transition")
+		float PreloadRadius;
+
+	/// How long the transition may wait for a preload that is still running before it falls back to a blocking load
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Transition")
+		float MaxPreloadWait;
+
+protected:
+	// Called when the game starts or when spawned
+	virtual void BeginPlay() override;
+
+public:
+	// Called every frame
+	virtual void Tick(float DeltaTime) override;
+
+	UFUNCTION()
+		virtual void OnOverlapBegin(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult);
+
+	UFUNCTION()
+		void PreloadOnOverlapBegin(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult);
+
+private:
+
+	/// switch as soon as the preload is done or MaxPreloadWait ran out
+	void WaitForPreload();
+
+	UPROPERTY()
+		class AMain* TransitioningMain;
+
+	FTimerHandle PreloadWaitTimer;
+
+	float PreloadWaitStart;
+};
@@ -1,39 +1,50 @@
-// Fill out your copyright notice in the Description page of Project Settings.
-
-#include "MainAnimInstance.h"
-#include "GameFramework/CharacterMovementComponent.h"
-#include "Main.h"
-
-void UMainAnimInstance::NativeInitializeAnimation()
-{
-	if (Pawn == nullptr)
-	{
-		Pawn = TryGetPawnOwner();
-		if (Pawn)
-		{
-			Main = Cast<AMain>(Pawn);
-		}
-	}
-}
-
-void UMainAnimInstance::UpdateAnimationProperties()
-{
-	if (Pawn == nullptr)
-	{
-		Pawn = TryGetPawnOwner();
-	}
-
-	if (Pawn)
-	{
-		FVector Speed = Pawn->GetVelocity();
-		FVector LateralSpeed = FVector(Speed.X, Speed.Y, 0.f);
-		MovementSpeed = LateralSpeed.Size();
-
-		bIsInAir = Pawn->GetMovementComponent()->IsFalling();
-
-		if (Main == nullptr)
-		{
-			Main = Cast<AMain>(Pawn);
-		}
-	}
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "MainAnimInstance.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "Main.h"
+
+void FMainAnimInstanceProxy::PreUpdate(UAnimInstance* InAnimInstance, float DeltaSeconds)
+{
+	Super::PreUpdate(InAnimInstance, DeltaSeconds);
+
+	UMainAnimInstance* AnimInstance = CastChecked<UMainAnimInstance>(InAnimInstance);
+
+	if (AnimInstance->Pawn == nullptr)
+	{
+		AnimInstance->Pawn = AnimInstance->TryGetPawnOwner();
+		AnimInstance->Main = Cast<AMain>(AnimInstance->Pawn);
+	}
+
+	APawn* Pawn = AnimInstance->Pawn;
+
+	Velocity = Pawn ? Pawn->GetVelocity() : FVector::ZeroVector;
+	bFalling = Pawn && Pawn->GetMovementComponent() && Pawn->GetMovementComponent()->IsFalling();
+}
+
+void FMainAnimInstanceProxy::Update(float DeltaSeconds)
+{
+	Super::Update(DeltaSeconds);
+
+	/// the game thread doesn't touch the instance while its proxy updates
+	UMainAnimInstance* AnimInstance = static_cast<UMainAnimInstance*>(GetAnimInstanceObject());
+
+	AnimInstance->MovementSpeed = FVector(Velocity.X, Velocity.Y, 0.f).Size();
+	AnimInstance->bIsInAir = bFalling;
+}
+
+void UMainAnimInstance::NativeInitializeAnimation()
+{
+	if (Pawn == nullptr)
+	{
+		Pawn = TryGetPawnOwner();
+		if (Pawn)
+		{
+			Main = Cast<AMain>(Pawn);
+		}
+	}
+}
+
+void UMainAnimInstance::UpdateAnimationProperties()
+{
 }
\ No newline at end of file
@@ -1,35 +1,74 @@
-// Fill out your copyright notice in the Description page of Project Settings.
-
-#pragma once
-
-#include "CoreMinimal.h"
-#include "Animation/AnimInstance.h"
-#include "MainAnimInstance.generated.h"
-
-/**
- *
- */
-UCLASS()
-class MYFIRSTPROJECT_API UMainAnimInstance: public UAnimInstance
-{
-	GENERATED_BODY()
-
-public:
-
-	virtual void NativeInitializeAnimation() override;
-
-	UFUNCTION(BluePrintCallable, Category = AnimationsProperties)
-		void UpdateAnimationProperties();
-
-	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Movement)
-		float MovementSpeed;
-
-	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Movement)
-		bool bIsInAir;
-
-	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Movement)
-		class APawn* Pawn;
-
-	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Movement)
-		class AMain* Main;
-};
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Animation/AnimInstance.h"
+#include "Animation/AnimInstanceProxy.h"
+#include "MainAnimInstance.generated.h"
+
+/// Pawn data copied on the game thread, the animation properties are computed from it on a worker thread
+USTRUCT()
+struct FMainAnimInstanceProxy: public FAnimInstanceProxy
+{
+	GENERATED_BODY()
+
+	FMainAnimInstanceProxy() {}
+
+	FMainAnimInstanceProxy(UAnimInstance* InAnimInstance): FAnimInstanceProxy(InAnimInstance) {}
+
+	/// game thread, before the parallel update
+	virtual void PreUpdate(UAnimInstance* InAnimInstance, float DeltaSeconds) override;
+
+	/// worker thread, before the anim graph reads the properties
+	virtual void Update(float DeltaSeconds) override;
+
+private:
+
+	FVector Velocity = FVector::ZeroVector;
+
+	bool bFalling = false;
+};
+
+/**
+ *
+ */
+UCLASS()
+class MYFIRSTPROJECT_API UMainAnimInstance: public UAnimInstance
+{
+	GENERATED_BODY()
+
+	friend struct FMainAnimInstanceProxy;
+
+public:
+
+	virtual void NativeInitializeAnimation() override;
+
+	/// The properties are filled by the native update now, kept for the event graphs that still call it
+	UFUNCTION(BluePrintCallable, Category = AnimationsProperties)
+		void UpdateAnimationProperties();
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Movement)
+		float MovementSpeed;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Movement)
+		bool bIsInAir;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Movement)
+		class APawn* Pawn;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Movement)
+		class AMain* Main;
+
+protected:
+
+	virtual FAnimInstanceProxy* CreateAnimInstanceProxy() override { return &Proxy; }
+
+	/// the proxy is a member, nothing to free
+	virtual void DestroyAnimInstanceProxy(FAnimInstanceProxy* InProxy) override {}
+
+private:
+
+	UPROPERTY(Transient)
+		FMainAnimInstanceProxy Proxy;
+};
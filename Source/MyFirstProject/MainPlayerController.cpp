@@ -1,116 +1,94 @@
-// Fill out your copyright notice in the Description page of Project Settings.
-
-#include "MainPlayerController.h"
-#include "Blueprint/UserWidget.h"
-
-void AMainPlayerController::BeginPlay()
-{
-	Super::BeginPlay();
-
-	if (HUDOverlayAsset)
-	{
-		HUDOverlay = CreateWidget<UUserWidget>(this, HUDOverlayAsset);
-	}
-
-	HUDOverlay->AddToViewport();
-	HUDOverlay->SetVisibility(ESlateVisibility::Visible); /// Set hud to visible /// it can be set to unvisible on the editor
-
-	if (WEnemyHealthBar)
-	{
-		EnemyHealthBar = CreateWidget<UUserWidget>(this, WEnemyHealthBar);
-		if (EnemyHealthBar)
-		{
-			EnemyHealthBar->AddToViewport();
-			EnemyHealthBar->SetVisibility(ESlateVisibility::Hidden);
-		}
-
-		FVector2D Alignment(0.f, 0.f);
-		EnemyHealthBar->SetAlignmentInViewport(Alignment);
-	}
-
-	if (WPauseMenu)
-	{
-		PauseMenu = CreateWidget<UUserWidget>(this, WPauseMenu);
-		if (PauseMenu)
-		{
-			PauseMenu->AddToViewport();
-			PauseMenu->SetVisibility(ESlateVisibility::Hidden);
-		}
-	}
-}
-
-void AMainPlayerController::Tick(float DeltaTime)
-{
-	Super::Tick(DeltaTime);
-
-	if (EnemyHealthBar)
-	{
-		FVector2D PositionInViewport;
-		ProjectWorldLocationToScreen(EnemyLocation, PositionInViewport);
-		PositionInViewport.Y -= 85.f;
-
-		FVector2D SizeInViewport(300.f, 25.f);
-
-		EnemyHealthBar->SetPositionInViewport(PositionInViewport);
-		EnemyHealthBar->SetDesiredSizeInViewport(SizeInViewport);
-	}
-}
-
-void AMainPlayerController::DisplayEnemyHealthBar()
-{
-	if (EnemyHealthBar)
-	{
-		bEnemyHealthBarVisible = true;
-		EnemyHealthBar->SetVisibility(ESlateVisibility::Visible);
-	}
-}
-
-void AMainPlayerController::RemoveEnemyHealthBar()
-{
-	if (EnemyHealthBar)
-	{
-		bEnemyHealthBarVisible = false;
-		EnemyHealthBar->SetVisibility(ESlateVisibility::Hidden);
-	}
-}
-
-void AMainPlayerController::DisplayPauseMenu_Implementation()
-{
-	if (PauseMenu)
-	{
-		FInputModeGameAndUI InputModeGameAndUI;
-		SetInputMode(InputModeGameAndUI);
-		bShowMouseCursor = true;
-
-		PauseMenu->SetVisibility(ESlateVisibility::Visible);
-		bPauseMenuVisible = true;
-	}
-}
-
-void AMainPlayerController::RemovePauseMenu_Implementation()
-{
-	if (PauseMenu)
-	{
-		FInputModeGameOnly InputModeGameOnly;
-		SetInputMode(InputModeGameOnly);
-		bShowMouseCursor = false;
-
-		bPauseMenuVisible = false;
-	}
-}
-
-void AMainPlayerController::TogglePauseMenu()
-{
-	if (bPauseMenuVisible)
-	{
-		RemovePauseMenu();
-	} else
-	{
-		DisplayPauseMenu();
-	}
-}
-
-void AMainPlayerController::RestartGame()
-{
-	RestartLevel();
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "MainPlayerController.h"
+#include "Blueprint/UserWidget.h"
+#include "EnemyHealthBarManager.h"
+#include "GameplayPerf.h"
+
+AMainPlayerController::AMainPlayerController()
+{
+	EnemyHealthBars = CreateDefaultSubobject<UEnemyHealthBarManager>(TEXT("EnemyHealthBars"));
+}
+
+void AMainPlayerController::BeginPlay()
+{
+	Super::BeginPlay();
+
+	if (HUDOverlayAsset)
+	{
+		HUDOverlay = CreateWidget<UUserWidget>(this, HUDOverlayAsset);
+	}
+
+	HUDOverlay->AddToViewport();
+	HUDOverlay->SetVisibility(ESlateVisibility::Visible); /// Set hud to visible /// it can be set to unvisible on the editor
+
+	EnemyHealthBars->CreatePool(WEnemyHealthBar);
+
+	if (WPauseMenu)
+	{
+		PauseMenu = CreateWidget<UUserWidget>(this, WPauseMenu);
+		if (PauseMenu)
+		{
+			PauseMenu->AddToViewport();
+			PauseMenu->SetVisibility(ESlateVisibility::Hidden);
+		}
+	}
+}
+
+void AMainPlayerController::Tick(float DeltaTime)
+{
+	GAMEPLAY_PERF_SCOPE(PlayerControllerTick);
+
+	Super::Tick(DeltaTime);
+}
+
+void AMainPlayerController::DisplayEnemyHealthBar()
+{
+	EnemyHealthBars->RequestRefresh();
+}
+
+void AMainPlayerController::RemoveEnemyHealthBar()
+{
+	EnemyHealthBars->RequestRefresh();
+}
+
+void AMainPlayerController::DisplayPauseMenu_Implementation()
+{
+	if (PauseMenu)
+	{
+		FInputModeGameAndUI InputModeGameAndUI;
+		SetInputMode(InputModeGameAndUI);
+		bShowMouseCursor = true;
+
+		PauseMenu->SetVisibility(ESlateVisibility::Visible);
+		bPauseMenuVisible = true;
+	}
+}
+
+void AMainPlayerController::RemovePauseMenu_Implementation()
+{
+	if (PauseMenu)
+	{
+		FInputModeGameOnly InputModeGameOnly;
+		SetInputMode(InputModeGameOnly);
+		bShowMouseCursor = false;
+
+		bPauseMenuVisible = false;
+	}
+}
+
+void AMainPlayerController::TogglePauseMenu()
+{
+	if (bPauseMenuVisible)
+	{
+		RemovePauseMenu();
+	} else
+	{
+		DisplayPauseMenu();
+	}
+}
+
+void AMainPlayerController::RestartGame()
+{
+	RestartLevel();
 }
\ No newline at end of file
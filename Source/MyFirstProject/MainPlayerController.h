@@ -1,63 +1,63 @@
-// Fill out your copyright notice in the Description page of Project Settings.
-
-#pragma once
-
-#include "CoreMinimal.h"
-#include "GameFramework/PlayerController.h"
-#include "MainPlayerController.generated.h"
-
-/**
- *
- */
-UCLASS()
-class MYFIRSTPROJECT_API AMainPlayerController: public APlayerController
-{
-	GENERATED_BODY()
-
-public:
-
-	/// Reference to the UMG Asset in the Editor
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Widgets")
-		TSubclassOf<class UUserWidget> HUDOverlayAsset;
-
-	/// Variable to hold the widget after creating it
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Widgets")
-		UUserWidget* HUDOverlay;
-
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Widgets")
-		TSubclassOf<class UUserWidget> WEnemyHealthBar;
-
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Widgets")
-		UUserWidget* EnemyHealthBar;
-
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Widgets")
-		TSubclassOf<class UUserWidget> WPauseMenu;
-
-	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Widgets")
-		UUserWidget* PauseMenu;
-
-	bool bEnemyHealthBarVisible;
-
-	bool bPauseMenuVisible;
-
-	FVector EnemyLocation;
-
-protected:
-	virtual void BeginPlay() override;
-	virtual void Tick(float DeltaTime) override;
-
-public:
-
-	void DisplayEnemyHealthBar();
-	void RemoveEnemyHealthBar();
-
-	UFUNCTION(BlueprintNativeEvent, BlueprintCallable, Category = "HUD")
-		void DisplayPauseMenu();
-
-	UFUNCTION(BlueprintNativeEvent, BlueprintCallable, Category = "HUD")
-		void RemovePauseMenu();
-
-	void TogglePauseMenu();
-
-	void RestartGame();
-};
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/PlayerController.h"
+#include "MainPlayerController.generated.h"
+
+/**
+ *
+ */
+UCLASS()
+class MYFIRSTPROJECT_API AMainPlayerController: public APlayerController
+{
+	GENERATED_BODY()
+
+public:
+
+	AMainPlayerController();
+
+	/// Reference to the UMG Asset in the Editor
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Widgets")
+		TSubclassOf<class UUserWidget> HUDOverlayAsset;
+
+	/// Variable to hold the widget after creating it
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Widgets")
+		UUserWidget* HUDOverlay;
+
+	/// Widget used for the floating enemy health bars, derive it from UEnemyHealthBarWidget to get a bar per engaged enemy
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Widgets")
+		TSubclassOf<class UUserWidget> WEnemyHealthBar;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Widgets")
+		class UEnemyHealthBarManager* EnemyHealthBars;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Widgets")
+		TSubclassOf<class UUserWidget> WPauseMenu;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Widgets")
+		UUserWidget* PauseMenu;
+
+	bool bPauseMenuVisible;
+
+protected:
+	virtual void BeginPlay() override;
+	virtual void Tick(float DeltaTime) override;
+
+public:
+
+	/// combat targets changed, update the enemy health bars now
+	void DisplayEnemyHealthBar();
+	void RemoveEnemyHealthBar();
+
+	UFUNCTION(BlueprintNativeEvent, BlueprintCallable, Category = "HUD")
+		void DisplayPauseMenu();
+
+	UFUNCTION(BlueprintNativeEvent, BlueprintCallable, Category = "HUD")
+		void RemovePauseMenu();
+
+	void TogglePauseMenu();
+
+	void RestartGame();
+};
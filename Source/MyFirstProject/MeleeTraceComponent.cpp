@@ -0,0 +1,124 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "MeleeTraceComponent.h"
+#include "Components/BoxComponent.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+
+UMeleeTraceComponent::UMeleeTraceComponent()
+{
+	PrimaryComponentTick.bCanEverTick = true;
+	PrimaryComponentTick.bStartWithTickEnabled = false; /// ticks only during a swing
+	PrimaryComponentTick.TickGroup = TG_PostPhysics; /// after the animation placed the weapon for this frame
+
+	MaxTargets = 0;
+	MaxStepDistance = 40.f;
+
+	TraceShape = nullptr;
+	SwingId = 0;
+	bSwinging = false;
+
+	SweepDelegate.BindUObject(this, &UMeleeTraceComponent::OnSweepCompleted);
+}
+
+void UMeleeTraceComponent::SetTraceShape(UBoxComponent* Shape)
+{
+	TraceShape = Shape;
+}
+
+void UMeleeTraceComponent::BeginSwing()
+{
+	if (!TraceShape) return;
+
+	SwingId++;
+	HitActors.Reset();
+
+	LastTransform = TraceShape->GetComponentTransform();
+	bSwinging = true;
+	SetComponentTickEnabled(true);
+}
+
+void UMeleeTraceComponent::EndSwing()
+{
+	if (!bSwinging) return;
+
+	SweepToCurrent(); /// the part of the path since the last tick
+
+	bSwinging = false;
+	SetComponentTickEnabled(false);
+}
+
+void UMeleeTraceComponent::CancelSwing()
+{
+	SwingId++; /// drops the results still in flight
+	bSwinging = false;
+	SetComponentTickEnabled(false);
+}
+
+void UMeleeTraceComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
+{
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+
+	if (bSwinging)
+	{
+		SweepToCurrent();
+	}
+}
+
+void UMeleeTraceComponent::SweepToCurrent()
+{
+	UWorld* World = GetWorld();
+	if (!World || !TraceShape) return;
+
+	const FTransform Current = TraceShape->GetComponentTransform();
+	const FVector Extent = TraceShape->GetScaledBoxExtent();
+
+	/// a rotating blade moves its tip much farther than its center, take both into account for the step count
+	const float Angle = LastTransform.GetRotation().AngularDistance(Current.GetRotation());
+	const float Travel = FVector::Dist(LastTransform.GetLocation(), Current.GetLocation()) + Angle * Extent.Size();
+	const int32 Steps = FMath::Clamp(FMath::CeilToInt(Travel / FMath::Max(MaxStepDistance, 1.f)), 1, 8);
+
+	FCollisionQueryParams Params(SCENE_QUERY_STAT(MeleeTrace), false);
+	Params.AddIgnoredActor(GetOwner());
+	if (AActor* Wielder = GetOwner()->GetAttachParentActor()) /// a weapon never hits whoever carries it
+	{
+		Params.AddIgnoredActor(Wielder);
+	}
+
+	/// object type query so every pawn along the path is reported, a channel query stops at the first blocking one
+	const FCollisionObjectQueryParams ObjectParams(ECC_Pawn);
+	const FCollisionShape Shape = FCollisionShape::MakeBox(Extent);
+
+	FTransform From = LastTransform;
+	for (int32 Step = 1; Step <= Steps; Step++)
+	{
+		const float Alpha = float(Step) / Steps;
+		const FVector To = FMath::Lerp(LastTransform.GetLocation(), Current.GetLocation(), Alpha);
+		const FQuat Rotation = FQuat::Slerp(LastTransform.GetRotation(), Current.GetRotation(), Alpha);
+
+		World->AsyncSweepByObjectType(EAsyncTraceType::Multi, From.GetLocation(), To, Rotation, ObjectParams, Shape, Params, &SweepDelegate, SwingId);
+
+		From.SetLocation(To);
+	}
+
+	LastTransform = Current;
+}
+
+void UMeleeTraceComponent::OnSweepCompleted(const FTraceHandle& Handle, FTraceDatum& Datum)
+{
+	if (Datum.UserData != SwingId) return; /// queued by a swing that is over
+
+	for (const FHitResult& Hit : Datum.OutHits)
+	{
+		if (MaxTargets > 0 && HitActors.Num() >= MaxTargets) return;
+
+		AActor* Actor = Hit.GetActor();
+		if (!Actor || (TargetClass && !Actor->IsA(TargetClass))) continue;
+
+		bool bAlreadyHit = false;
+		HitActors.Add(Actor, &bAlreadyHit);
+		if (bAlreadyHit) continue; /// capsule and mesh of the same actor, or the same actor in the next sweep
+
+		OnHit.ExecuteIfBound(Hit);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,81 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "WorldCollision.h"
+#include "MeleeTraceComponent.generated.h"
+
+DECLARE_DELEGATE_OneParam(FOnMeleeHit, const FHitResult&);
+
+/**
+ * Melee hit detection that sweeps a box shape along the path it moved since last frame, so fast swings at low
+ * frame rates can't pass through a target between two frames. The sweeps go through the async trace batch and
+ * every actor is reported once per swing, up to MaxTargets for cleaving attacks
+ */
+UCLASS(ClassGroup = (Custom), meta = (BlueprintSpawnableComponent))
+class MYFIRSTPROJECT_API UMeleeTraceComponent: public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+
+	UMeleeTraceComponent();
+
+	/// Actors hit per swing, 0 for every actor the swing passes through
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Combat")
+		int32 MaxTargets;
+
+	/// Longest step between two sweeps of a swing, larger moves are split so an arc isn't cut short by a straight line
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Combat")
+		float MaxStepDistance;
+
+	/// Only actors of this class are reported
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Combat")
+		TSubclassOf<AActor> TargetClass;
+
+	/// Called once for each new actor hit during a swing
+	FOnMeleeHit OnHit;
+
+	/// Sweep this box, usually the owner's combat collision, it should have collision disabled
+	void SetTraceShape(class UBoxComponent* Shape);
+
+	/// Start a swing, the hits of the previous one are forgotten
+	UFUNCTION(BlueprintCallable, Category = "Combat")
+		void BeginSwing();
+
+	/// Sweep the last stretch and stop, hits of sweeps still in flight are reported next frame
+	UFUNCTION(BlueprintCallable, Category = "Combat")
+		void EndSwing();
+
+	/// Stop without reporting anything more, for attacks interrupted by death or reuse
+	void CancelSwing();
+
+	UFUNCTION(BlueprintPure, Category = "Combat")
+		bool IsSwinging() const { return bSwinging; }
+
+	virtual void TickComponent(float DeltaTime, enum ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
+
+private:
+
+	/// queue the async sweeps from the last traced transform to the shape's current one
+	void SweepToCurrent();
+
+	void OnSweepCompleted(const FTraceHandle& Handle, FTraceDatum& Datum);
+
+	UPROPERTY()
+		UBoxComponent* TraceShape;
+
+	FTransform LastTransform;
+
+	/// actors already hit by the current swing
+	TSet<TWeakObjectPtr<AActor>> HitActors;
+
+	/// results of sweeps queued for an older swing are dropped
+	uint32 SwingId;
+
+	bool bSwinging;
+
+	FTraceDelegate SweepDelegate;
+};
@@ -1,6 +1,6 @@
-// Copyright Epic Games, Inc. All Rights Reserved.
-
-#include "MyFirstProject.h"
-#include "Modules/ModuleManager.h"
-
-IMPLEMENT_PRIMARY_GAME_MODULE( FDefaultGameModuleImpl, MyFirstProject, "MyFirstProject" );
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#include "MyFirstProject.h"
+#include "Modules/ModuleManager.h"
+
+IMPLEMENT_PRIMARY_GAME_MODULE( FDefaultGameModuleImpl, MyFirstProject, "MyFirstProject" );
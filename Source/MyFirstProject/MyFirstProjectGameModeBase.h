@@ -1,17 +1,17 @@
-// Copyright Epic Games, Inc. All Rights Reserved.
-
-#pragma once
-
-#include "CoreMinimal.h"
-#include "GameFramework/GameModeBase.h"
-#include "MyFirstProjectGameModeBase.generated.h"
-
-/**
- * 
- */
-UCLASS()
-class MYFIRSTPROJECT_API AMyFirstProjectGameModeBase : public AGameModeBase
-{
-	GENERATED_BODY()
-	
-};
+// Copyright Epic Games, Inc. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/GameModeBase.h"
+#include "MyFirstProjectGameModeBase.generated.h"
+
+/**
+ * 
+ */
+UCLASS()
+class MYFIRSTPROJECT_API AMyFirstProjectGameModeBase : public AGameModeBase
+{
+	GENERATED_BODY()
+	
+};
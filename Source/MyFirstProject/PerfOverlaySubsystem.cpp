@@ -0,0 +1,131 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "PerfOverlaySubsystem.h"
+#include "Engine/World.h"
+#include "Engine/Engine.h"
+#include "Engine/Canvas.h"
+#include "Debug/DebugDrawService.h"
+#include "GameFramework/PlayerController.h"
+#include "RenderCore.h"
+#include "RHI.h"
+#include "EnemySignificanceSubsystem.h"
+#include "AnimationBudgetSubsystem.h"
+
+static TAutoConsoleVariable<int32> CVarPerfOverlay(
+	TEXT("game.PerfOverlay"),
+	0,
+	TEXT("1: draw frame and thread times, the MyFirstProject hot paths and gameplay counters on screen"));
+
+UPerfOverlaySubsystem::UPerfOverlaySubsystem()
+{
+	FMemory::Memzero(SectionMs);
+
+	LiveEnemies = 0;
+	OverlapsPerFrame = 0;
+	SpawnsPerSecond = 0.f;
+
+	SpawnWindowCount = 0;
+	SpawnWindowTime = 0.f;
+
+	SmoothedFrameMs = 0.f;
+}
+
+void UPerfOverlaySubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	DrawHandle = UDebugDrawService::Register(TEXT("Game"), FDebugDrawDelegate::CreateUObject(this, &UPerfOverlaySubsystem::DrawOverlay));
+}
+
+void UPerfOverlaySubsystem::Deinitialize()
+{
+	if (DrawHandle.IsValid())
+	{
+		UDebugDrawService::Unregister(DrawHandle);
+		DrawHandle.Reset();
+	}
+
+	Super::Deinitialize();
+}
+
+void UPerfOverlaySubsystem::Tick(float DeltaTime)
+{
+	for (int32 i = 0; i < (int32)EGameplayPerfSection::MAX; i++)
+	{
+		SectionMs[i] = FMath::Lerp(SectionMs[i], float(FPlatformTime::ToMilliseconds64(FGameplayPerfCounters::SectionCycles[i])), 0.1f);
+		FGameplayPerfCounters::SectionCycles[i] = 0;
+	}
+
+	OverlapsPerFrame = FGameplayPerfCounters::Overlaps;
+	FGameplayPerfCounters::Overlaps = 0;
+
+	SpawnWindowCount += FGameplayPerfCounters::Spawns;
+	FGameplayPerfCounters::Spawns = 0;
+	SpawnWindowTime += DeltaTime;
+
+	if (SpawnWindowTime >= 1.f)
+	{
+		SpawnsPerSecond = SpawnWindowCount / SpawnWindowTime;
+		SpawnWindowCount = 0;
+		SpawnWindowTime = 0.f;
+	}
+
+	if (UEnemySignificanceSubsystem* Significance = GetWorld()->GetSubsystem<UEnemySignificanceSubsystem>())
+	{
+		LiveEnemies = Significance->GetNumEnemies();
+	}
+
+	SmoothedFrameMs = FMath::Lerp(SmoothedFrameMs, DeltaTime * 1000.f, 0.1f);
+
+	SET_DWORD_STAT(STAT_LiveEnemies, LiveEnemies);
+	SET_DWORD_STAT(STAT_OverlapsPerFrame, OverlapsPerFrame);
+	SET_FLOAT_STAT(STAT_SpawnsPerSecond, SpawnsPerSecond);
+
+	CSV_CUSTOM_STAT(MyFirstProject, LiveEnemies, LiveEnemies, ECsvCustomStatOp::Set);
+	CSV_CUSTOM_STAT(MyFirstProject, OverlapsPerFrame, OverlapsPerFrame, ECsvCustomStatOp::Set);
+	CSV_CUSTOM_STAT(MyFirstProject, SpawnsPerSecond, SpawnsPerSecond, ECsvCustomStatOp::Set);
+}
+
+void UPerfOverlaySubsystem::DrawOverlay(UCanvas* Canvas, APlayerController* PlayerController)
+{
+	/// the draw service is shared by every world (PIE clients), draw only our own
+	if (CVarPerfOverlay.GetValueOnGameThread() == 0 || !Canvas || !PlayerController || PlayerController->GetWorld() != GetWorld()) return;
+
+	UFont* Font = GEngine->GetSmallFont();
+	const float LineHeight = Font->GetMaxCharHeight() + 2.f;
+
+	float X = 50.f;
+	float Y = 100.f;
+
+	auto DrawLine = [&](const FString& Text, const FLinearColor& Color)
+	{
+		Canvas->SetDrawColor(Color.ToFColor(true));
+		Canvas->DrawText(Font, Text, X, Y);
+		Y += LineHeight;
+	};
+
+	DrawLine(FString::Printf(TEXT("Frame %.2fms (%.0f fps)"), SmoothedFrameMs, SmoothedFrameMs > 0.f ? 1000.f / SmoothedFrameMs : 0.f), FLinearColor::White);
+	DrawLine(FString::Printf(TEXT("Game %.2fms  Render %.2fms  GPU %.2fms"),
+		FPlatformTime::ToMilliseconds(GGameThreadTime), FPlatformTime::ToMilliseconds(GRenderThreadTime), FPlatformTime::ToMilliseconds(RHIGetGPUFrameCycles())), FLinearColor::White);
+
+	Y += LineHeight * 0.5f;
+
+	for (int32 i = 0; i < (int32)EGameplayPerfSection::MAX; i++)
+	{
+		const float Ms = SectionMs[i];
+		const FLinearColor Color = Ms > 1.f ? FLinearColor::Red : (Ms > 0.25f ? FLinearColor::Yellow : FLinearColor::Green);
+
+		DrawLine(FString::Printf(TEXT("%-22s %.3fms"), FGameplayPerfCounters::GetSectionName((EGameplayPerfSection)i), Ms), Color);
+	}
+
+	Y += LineHeight * 0.5f;
+
+	DrawLine(FString::Printf(TEXT("Live enemies %d  Overlaps/frame %d  Spawns/s %.1f"), LiveEnemies, OverlapsPerFrame, SpawnsPerSecond), FLinearColor::White);
+
+	if (UAnimationBudgetSubsystem* AnimationBudget = GetWorld()->GetSubsystem<UAnimationBudgetSubsystem>())
+	{
+		const FAnimationBudgetStats Stats = AnimationBudget->GetStats();
+
+		DrawLine(FString::Printf(TEXT("Enemy animation %.2f / %.2fms"), Stats.AverageUsedMs, Stats.BudgetMs), Stats.AverageUsedMs > Stats.BudgetMs ? FLinearColor::Red : FLinearColor::White);
+	}
+}
\ No newline at end of file
@@ -0,0 +1,48 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "TickableGameplaySubsystem.h"
+#include "GameplayPerf.h"
+#include "PerfOverlaySubsystem.generated.h"
+
+/**
+ * Turns the gameplay perf counters into per-frame values for stat MyFirstProject and the CSV profile, and draws
+ * them with the thread times on screen while game.PerfOverlay is on. Works in every build configuration
+ */
+UCLASS()
+class MYFIRSTPROJECT_API UPerfOverlaySubsystem: public UTickableGameplaySubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	UPerfOverlaySubsystem();
+
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+
+	virtual void Deinitialize() override;
+
+	virtual void Tick(float DeltaTime) override;
+
+private:
+
+	void DrawOverlay(class UCanvas* Canvas, class APlayerController* PlayerController);
+
+	float SectionMs[(int32)EGameplayPerfSection::MAX];
+
+	int32 LiveEnemies;
+
+	int32 OverlapsPerFrame;
+
+	float SpawnsPerSecond;
+
+	/// spawns counted and seconds passed since SpawnsPerSecond was last updated
+	uint32 SpawnWindowCount;
+	float SpawnWindowTime;
+
+	float SmoothedFrameMs;
+
+	FDelegateHandle DrawHandle;
+};
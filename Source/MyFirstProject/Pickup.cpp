@@ -1,45 +1,45 @@
-// Fill out your copyright notice in the Description page of Project Settings.
-
-#include "Pickup.h"
-#include "Main.h"
-#include "Kismet/GameplayStatics.h"
-#include "Sound/SoundCue.h"
-
-APickup::APickup()
-{
-}
-
-void APickup::OnOverlapBegin(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult)
-{
-	/// Super is used to call the parent element functionality
-	Super::OnOverlapBegin(OverlappedComponent, OtherActor, OtherComp, OtherBodyIndex, bFromSweep, SweepResult);
-
-	if (OtherActor)
-	{
-		AMain* Main = Cast<AMain>(OtherActor); /// Cast the other actor into Main and save it into the variable
-
-		if (Main)
-		{
-			Main->PickupLocations.Add(GetActorLocation());
-
-			OnPickupBP(Main);
-
-			if (OverlapParticles)
-			{
-				UGameplayStatics::SpawnEmitterAtLocation(GetWorld(), OverlapParticles, GetActorLocation(), FRotator(0.f), true);
-			}
-
-			if (OverlapSound)
-			{
-				UGameplayStatics::PlaySound2D(this, OverlapSound);
-			}
-
-			Destroy();
-		}
-	}
-}
-
-void APickup::OnOverlapEnd(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex)
-{
-	Super::OnOverlapEnd(OverlappedComponent, OtherActor, OtherComp, OtherBodyIndex);
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Pickup.h"
+#include "Main.h"
+#include "Kismet/GameplayStatics.h"
+#include "Sound/SoundCue.h"
+
+APickup::APickup()
+{
+}
+
+void APickup::OnOverlapBegin(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult)
+{
+	/// Super is used to call the parent element functionality
+	Super::OnOverlapBegin(OverlappedComponent, OtherActor, OtherComp, OtherBodyIndex, bFromSweep, SweepResult);
+
+	if (OtherActor)
+	{
+		AMain* Main = Cast<AMain>(OtherActor); /// Cast the other actor into Main and save it into the variable
+
+		if (Main)
+		{
+			Main->RecordPickup(GetActorLocation());
+
+			OnPickupBP(Main);
+
+			if (OverlapParticles)
+			{
+				UGameplayStatics::SpawnEmitterAtLocation(GetWorld(), OverlapParticles, GetActorLocation(), FRotator(0.f), true);
+			}
+
+			if (OverlapSound)
+			{
+				UGameplayStatics::PlaySound2D(this, OverlapSound);
+			}
+
+			Destroy();
+		}
+	}
+}
+
+void APickup::OnOverlapEnd(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex)
+{
+	Super::OnOverlapEnd(OverlappedComponent, OtherActor, OtherComp, OtherBodyIndex);
 }
\ No newline at end of file
@@ -1,28 +1,28 @@
-// Fill out your copyright notice in the Description page of Project Settings.
-
-#pragma once
-
-#include "CoreMinimal.h"
-#include "Item.h"
-#include "Pickup.generated.h"
-
-/**
- *
- */
-UCLASS()
-class MYFIRSTPROJECT_API APickup: public AItem
-{
-	GENERATED_BODY()
-
-public:
-
-	APickup();
-
-	/// Important: UFUNCTION macros will be inherited from the parent class
-
-	virtual void OnOverlapBegin(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult) override;
-
-	virtual void OnOverlapEnd(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex) override;
-	UFUNCTION(BlueprintImplementableEvent, Category = "Pickup")
-		void OnPickupBP(class AMain* Target);
-};
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Item.h"
+#include "Pickup.generated.h"
+
+/**
+ *
+ */
+UCLASS()
+class MYFIRSTPROJECT_API APickup: public AItem
+{
+	GENERATED_BODY()
+
+public:
+
+	APickup();
+
+	/// Important: UFUNCTION macros will be inherited from the parent class
+
+	virtual void OnOverlapBegin(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult) override;
+
+	virtual void OnOverlapEnd(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex) override;
+	UFUNCTION(BlueprintImplementableEvent, Category = "Pickup")
+		void OnPickupBP(class AMain* Target);
+};
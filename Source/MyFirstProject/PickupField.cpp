@@ -0,0 +1,148 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "PickupField.h"
+#include "Components/HierarchicalInstancedStaticMeshComponent.h"
+#include "Kismet/GameplayStatics.h"
+#include "Sound/SoundCue.h"
+#include "CombatFXSubsystem.h"
+#include "Main.h"
+
+APickupField::APickupField()
+{
+	PrimaryActorTick.bCanEverTick = true;
+
+	Instances = CreateDefaultSubobject<UHierarchicalInstancedStaticMeshComponent>(TEXT("Instances"));
+	RootComponent = Instances;
+
+	Instances->SetCollisionEnabled(ECollisionEnabled::NoCollision); /// collection goes through the grid, not overlaps
+	Instances->SetCanEverAffectNavigation(false);
+	Instances->SetCastShadow(false);
+
+	DefaultValue = 1;
+	CollectRadius = 80.f;
+	CellSize = 500.f;
+	bAddCoins = true;
+
+	CollectParticles = nullptr;
+	CollectSound = nullptr;
+
+	Remaining = 0;
+}
+
+void APickupField::OnConstruction(const FTransform& Transform)
+{
+	Super::OnConstruction(Transform);
+
+	RebuildInstances();
+}
+
+void APickupField::BeginPlay()
+{
+	Super::BeginPlay();
+
+	BuildGrid();
+
+	SetActorTickEnabled(Remaining > 0);
+}
+
+void APickupField::RebuildInstances()
+{
+	Instances->ClearInstances();
+
+	TArray<FTransform> Transforms;
+	Transforms.Reserve(PickupPoints.Num());
+	for (const FVector& Point : PickupPoints)
+	{
+		Transforms.Emplace(Point);
+	}
+	Instances->AddInstances(Transforms, false);
+}
+
+void APickupField::BuildGrid()
+{
+	const FTransform& ActorTransform = GetActorTransform();
+
+	Locations.Reset(PickupPoints.Num());
+	Values.Reset(PickupPoints.Num());
+	Cells.Reset();
+
+	for (int32 Index = 0; Index < PickupPoints.Num(); Index++)
+	{
+		const FVector Location = ActorTransform.TransformPosition(PickupPoints[Index]);
+		Locations.Add(Location);
+		Values.Add(PickupValues.IsValidIndex(Index) ? PickupValues[Index] : DefaultValue);
+		Cells.FindOrAdd(GetCell(Location)).Add(Index);
+	}
+
+	Remaining = Locations.Num();
+}
+
+void APickupField::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	AMain* Main = Cast<AMain>(UGameplayStatics::GetPlayerCharacter(this, 0));
+	if (!Main || Main->MovementStatus == EMovementStatus::EMS_Dead) return;
+
+	const FVector Center = Main->GetActorLocation();
+	const float RadiusSquared = CollectRadius * CollectRadius;
+	const FIntPoint MinCell = GetCell(Center - FVector(CollectRadius));
+	const FIntPoint MaxCell = GetCell(Center + FVector(CollectRadius));
+
+	bool bCollected = false;
+
+	for (int32 X = MinCell.X; X <= MaxCell.X; X++)
+	{
+		for (int32 Y = MinCell.Y; Y <= MaxCell.Y; Y++)
+		{
+			TArray<int32>* Cell = Cells.Find(FIntPoint(X, Y));
+			if (!Cell) continue;
+
+			for (int32 i = Cell->Num() - 1; i >= 0; i--) /// backwards so collecting doesn't skip any
+			{
+				const int32 Index = (*Cell)[i];
+				if (FVector::DistSquared(Locations[Index], Center) > RadiusSquared) continue;
+
+				Cell->RemoveAtSwap(i, 1, false);
+				Collect(Index, Main);
+				bCollected = true;
+			}
+		}
+	}
+
+	if (bCollected)
+	{
+		Instances->MarkRenderStateDirty(); /// once for every instance hidden this frame
+
+		if (Remaining == 0)
+		{
+			SetActorTickEnabled(false); /// nothing left to collect
+		}
+	}
+}
+
+void APickupField::Collect(int32 Index, AMain* Main)
+{
+	/// zero scale instead of RemoveInstance, which would reorder the instances and rebuild the cluster tree
+	FTransform Hidden = FTransform(PickupPoints[Index]);
+	Hidden.SetScale3D(FVector::ZeroVector);
+	Instances->UpdateInstanceTransform(Index, Hidden, false, false);
+
+	Remaining--;
+
+	const FVector& Location = Locations[Index];
+
+	Main->RecordPickup(Location);
+
+	if (bAddCoins)
+	{
+		Main->IncrementCoins(Values[Index]);
+	}
+
+	OnPickupBP(Main, Values[Index], Location);
+
+	if (UCombatFXSubsystem* FX = GetWorld()->GetSubsystem<UCombatFXSubsystem>()) /// pooled and merged, grabbing a row of coins plays one effect
+	{
+		FX->PlayHitEffect(CollectParticles, CollectSound, Location);
+	}
+}
\ No newline at end of file
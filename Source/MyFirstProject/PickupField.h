@@ -0,0 +1,93 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "PickupField.generated.h"
+
+/**
+ * Thousands of coins as instances of one hierarchical instanced mesh instead of an APickup actor each
+ * The player is tested against a grid of the remaining pickups, collecting one only hides its instance
+ */
+UCLASS()
+class MYFIRSTPROJECT_API APickupField: public AActor
+{
+	GENERATED_BODY()
+
+public:
+
+	APickupField();
+
+	/// All pickups of the field, set the mesh and material here
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Pickup")
+		class UHierarchicalInstancedStaticMeshComponent* Instances;
+
+	/// Pickup locations relative to the actor
+	UPROPERTY(EditAnywhere, Category = "Pickup", meta = (MakeEditWidget = "true"))
+		TArray<FVector> PickupPoints;
+
+	/// Coins given by each pickup point, missing entries use DefaultValue
+	UPROPERTY(EditAnywhere, Category = "Pickup")
+		TArray<int32> PickupValues;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Pickup")
+		int32 DefaultValue;
+
+	/// Pickups whose center is this close to the player are collected
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Pickup")
+		float CollectRadius;
+
+	/// Size of one grid cell in world units
+	UPROPERTY(EditAnywhere, Category = "Pickup")
+		float CellSize;
+
+	/// Add the value to the player's coins natively, turn off if OnPickupBP does it
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Pickup")
+		bool bAddCoins;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Pickup | Particles")
+		class UParticleSystem* CollectParticles;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Pickup | Sounds")
+		class USoundCue* CollectSound;
+
+	/// Called for every collected pickup like APickup::OnPickupBP
+	UFUNCTION(BlueprintImplementableEvent, Category = "Pickup")
+		void OnPickupBP(class AMain* Target, int32 Value, FVector Location);
+
+	UFUNCTION(BlueprintPure, Category = "Pickup")
+		int32 GetRemainingCount() const { return Remaining; }
+
+	virtual void OnConstruction(const FTransform& Transform) override;
+
+	virtual void Tick(float DeltaTime) override;
+
+protected:
+
+	virtual void BeginPlay() override;
+
+private:
+
+	FORCEINLINE FIntPoint GetCell(const FVector& Location) const
+	{
+		return FIntPoint(FMath::FloorToInt(Location.X / CellSize), FMath::FloorToInt(Location.Y / CellSize));
+	}
+
+	/// one instance per pickup point, instance index == pickup index
+	void RebuildInstances();
+
+	void BuildGrid();
+
+	/// hide the instance and hand the value to the player
+	void Collect(int32 Index, AMain* Main);
+
+	/// world location and value of each pickup, indexed like the instances
+	TArray<FVector> Locations;
+	TArray<int32> Values;
+
+	/// pickup indices of the remaining pickups in each occupied cell
+	TMap<FIntPoint, TArray<int32>> Cells;
+
+	int32 Remaining;
+};
@@ -0,0 +1,108 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "PickupHistory.h"
+#include "Engine/World.h"
+#include "Kismet/GameplayStatics.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/MemoryWriter.h"
+#include "Main.h"
+
+static FAutoConsoleCommandWithWorldAndArgs PickupHeatmapCommand(
+	TEXT("Pickups.ExportHeatmap"),
+	TEXT("Export the player's pickup heatmap to Saved/Heatmaps, 'bin' for the compact binary format, CSV otherwise"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+{
+	if (AMain* Main = Cast<AMain>(UGameplayStatics::GetPlayerCharacter(World, 0)))
+	{
+		Main->ExportPickupHeatmap(Args.Num() > 0 && Args[0] == TEXT("bin"));
+	}
+}));
+
+FPickupHistory::FPickupHistory(int32 InCapacity, float InHeatmapCellSize)
+{
+	Capacity = FMath::Max(InCapacity, 1);
+	HeatmapCellSize = FMath::Max(InHeatmapCellSize, 1.f);
+
+	Samples.SetNumUninitialized(Capacity); /// allocated once, recording never grows it
+	Head = 0;
+	Count = 0;
+	Total = 0;
+}
+
+void FPickupHistory::Record(const FVector& Location, float WorldTime)
+{
+	Samples[Head] = Quantize(Location, WorldTime);
+	Head = (Head + 1) % Capacity;
+	Count = FMath::Min(Count + 1, Capacity);
+	Total++;
+
+	const FIntPoint Cell(FMath::FloorToInt(Location.X / HeatmapCellSize), FMath::FloorToInt(Location.Y / HeatmapCellSize));
+	Heatmap.FindOrAdd(Cell)++;
+}
+
+void FPickupHistory::Reset()
+{
+	Head = 0;
+	Count = 0;
+	Total = 0;
+	Heatmap.Reset();
+}
+
+FPickupHistory::FSample FPickupHistory::Quantize(const FVector& Location, float WorldTime)
+{
+	auto Axis = [](float Value)
+	{
+		return (int16)FMath::Clamp(FMath::RoundToInt(Value / Quantum), (int32)MIN_int16, (int32)MAX_int16);
+	};
+
+	FSample Sample;
+	Sample.X = Axis(Location.X);
+	Sample.Y = Axis(Location.Y);
+	Sample.Z = Axis(Location.Z);
+	Sample.Time = WorldTime;
+	return Sample;
+}
+
+FVector FPickupHistory::Dequantize(const FSample& Sample)
+{
+	return FVector(Sample.X, Sample.Y, Sample.Z) * Quantum;
+}
+
+bool FPickupHistory::ExportHeatmapCSV(const FString& FileName) const
+{
+	FString CSV = TEXT("CellX,CellY,WorldX,WorldY,Count\n");
+	for (const auto& Pair : Heatmap)
+	{
+		CSV += FString::Printf(TEXT("%d,%d,%.0f,%.0f,%u\n"), Pair.Key.X, Pair.Key.Y, (Pair.Key.X + 0.5f) * HeatmapCellSize, (Pair.Key.Y + 0.5f) * HeatmapCellSize, Pair.Value);
+	}
+
+	return FFileHelper::SaveStringToFile(CSV, *FileName);
+}
+
+bool FPickupHistory::ExportHeatmapBinary(const FString& FileName) const
+{
+	TArray<uint8> Bytes;
+	FMemoryWriter Writer(Bytes);
+
+	uint32 Magic = 0x4D484B50; /// "PKHM" little endian
+	int32 Version = 1;
+	float CellSize = HeatmapCellSize;
+	int32 NumCells = Heatmap.Num();
+	Writer << Magic << Version << CellSize << NumCells;
+
+	for (const auto& Pair : Heatmap)
+	{
+		int32 X = Pair.Key.X;
+		int32 Y = Pair.Key.Y;
+		uint32 Value = Pair.Value;
+		Writer << X << Y << Value;
+	}
+
+	return FFileHelper::SaveArrayToFile(Bytes, *FileName);
+}
+
+FString FPickupHistory::MakeExportFileName(const TCHAR* Extension)
+{
+	return FPaths::ProjectSavedDir() / TEXT("Heatmaps") / FString::Printf(TEXT("PickupHeatmap_%s.%s"), *FDateTime::Now().ToString(), Extension);
+}
\ No newline at end of file
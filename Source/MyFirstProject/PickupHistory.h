@@ -0,0 +1,82 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Where and when the player picked things up, in fixed memory however long the session runs
+ * The latest Capacity pickups are kept in a ring buffer of quantized positions, every pickup also counts
+ * into a coarse heatmap grid that can be exported for route analysis
+ */
+class MYFIRSTPROJECT_API FPickupHistory
+{
+public:
+
+	/// Units per quantization step, positions are stored as int16 so the range is +-32767 steps
+	static constexpr float Quantum = 8.f;
+
+	struct FSample
+	{
+		int16 X;
+		int16 Y;
+		int16 Z;
+		/// world time in seconds
+		float Time;
+	};
+
+	explicit FPickupHistory(int32 InCapacity = 1024, float InHeatmapCellSize = 500.f);
+
+	void Record(const FVector& Location, float WorldTime);
+
+	void Reset();
+
+	/// Number of samples in the ring buffer
+	FORCEINLINE int32 Num() const { return Count; }
+
+	/// Pickups recorded since the last reset, including the ones the ring buffer dropped
+	FORCEINLINE int32 TotalRecorded() const { return Total; }
+
+	/// Call Visitor(Location, WorldTime) on the buffered samples, oldest first
+	template<typename VisitorType>
+	void ForEach(VisitorType&& Visitor) const
+	{
+		const int32 Oldest = (Head - Count + Capacity) % Capacity;
+		for (int32 i = 0; i < Count; i++)
+		{
+			const FSample& Sample = Samples[(Oldest + i) % Capacity];
+			Visitor(Dequantize(Sample), Sample.Time);
+		}
+	}
+
+	/// Write the heatmap as CellX,CellY,WorldX,WorldY,Count lines
+	bool ExportHeatmapCSV(const FString& FileName) const;
+
+	/**
+	* Write the heatmap as binary: 'PKHM', version, cell size, cell count, then X, Y (int32) and Count (uint32) per cell
+	* About 12 bytes per visited cell whatever the session length
+	*/
+	bool ExportHeatmapBinary(const FString& FileName) const;
+
+	/// Saved/Heatmaps/PickupHeatmap_<date>.<Extension>
+	static FString MakeExportFileName(const TCHAR* Extension);
+
+private:
+
+	static FSample Quantize(const FVector& Location, float WorldTime);
+
+	static FVector Dequantize(const FSample& Sample);
+
+	TArray<FSample> Samples;
+
+	/// slot the next sample is written to
+	int32 Head;
+	int32 Count;
+	int32 Capacity;
+	int32 Total;
+
+	float HeatmapCellSize;
+
+	/// pickups per visited XY cell
+	TMap<FIntPoint, uint32> Heatmap;
+};
@@ -0,0 +1,191 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "PlatformMoverSubsystem.h"
+#include "Engine/Level.h"
+#include "Engine/World.h"
+#include "FloatingPlatform.h"
+
+void FPlatformMotion::Init(const FVector& A, const FVector& B, float InInterpSpeed, float InPauseTime, float InStartTime)
+{
+	PointA = A;
+	PointB = B;
+	InterpSpeed = FMath::Max(InInterpSpeed, KINDA_SMALL_NUMBER);
+	PauseTime = FMath::Max(InPauseTime, 0.f);
+	StartTime = InStartTime;
+
+	/// time for the remaining distance to shrink under 1 unit, where the old per-frame VInterpTo stopped
+	const float Distance = (B - A).Size();
+	MoveTime = Distance > 1.f ? FMath::Loge(Distance) / InterpSpeed : 0.f;
+}
+
+FVector FPlatformMotion::Evaluate(float Time, bool& bOutMoving, float& OutSegmentEnd) const
+{
+	const float HalfPeriod = PauseTime + MoveTime;
+	if (HalfPeriod <= 0.f)
+	{
+		bOutMoving = false;
+		OutSegmentEnd = BIG_NUMBER;
+		return PointA;
+	}
+
+	const float Elapsed = FMath::Max(Time - StartTime, 0.f);
+	const int32 HalfCycle = FMath::FloorToInt(Elapsed / HalfPeriod);
+	const float CycleStart = StartTime + HalfCycle * HalfPeriod;
+	const float Local = Elapsed - HalfCycle * HalfPeriod;
+
+	const bool bForward = (HalfCycle & 1) == 0;
+	const FVector& From = bForward ? PointA : PointB;
+	const FVector& To = bForward ? PointB : PointA;
+
+	if (Local < PauseTime)
+	{
+		bOutMoving = false;
+		OutSegmentEnd = CycleStart + PauseTime;
+		return From;
+	}
+
+	bOutMoving = true;
+	OutSegmentEnd = CycleStart + HalfPeriod;
+	return To + (From - To) * FMath::Exp(-InterpSpeed * (Local - PauseTime));
+}
+
+void FPlatformMoverTickFunction::ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent)
+{
+	if (Mover && TickType != LEVELTICK_ViewportsOnly)
+	{
+		Mover->UpdatePlatforms();
+	}
+}
+
+void UPlatformMoverSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	TickFunction.Mover = this;
+	TickFunction.bCanEverTick = true;
+	TickFunction.bHighPriority = true; /// before the characters standing on the platforms move
+	TickFunction.TickGroup = TG_PrePhysics;
+	TickFunction.RegisterTickFunction(InWorld.PersistentLevel);
+}
+
+void UPlatformMoverSubsystem::Deinitialize()
+{
+	TickFunction.UnRegisterTickFunction();
+	TickFunction.Mover = nullptr;
+
+	Entries.Reset();
+	EntryIndices.Reset();
+	FreeEntries.Reset();
+	Moving.Reset();
+	Sleeping.Reset();
+
+	Super::Deinitialize();
+}
+
+void UPlatformMoverSubsystem::Register(AFloatingPlatform* Platform, const FPlatformMotion& Motion)
+{
+	if (!Platform) return;
+
+	int32 EntryIndex;
+	if (const int32* Existing = EntryIndices.Find(Platform))
+	{
+		EntryIndex = *Existing;
+	} else if (FreeEntries.Num() > 0) /// a stale heap entry still pointing at a reused slot only wakes the new platform early which is harmless
+	{
+		EntryIndex = FreeEntries.Pop(false);
+	} else
+	{
+		EntryIndex = Entries.AddDefaulted();
+	}
+	EntryIndices.Add(Platform, EntryIndex);
+
+	Entries[EntryIndex].Platform = Platform;
+	Entries[EntryIndex].Motion = Motion;
+
+	UpdateEntry(EntryIndex, GetWorld()->GetTimeSeconds());
+}
+
+void UPlatformMoverSubsystem::Unregister(AFloatingPlatform* Platform)
+{
+	int32 EntryIndex;
+	if (EntryIndices.RemoveAndCopyValue(Platform, EntryIndex))
+	{
+		Entries[EntryIndex].Platform.Reset(); /// dropped from Moving and Sleeping the next time they reach it
+		FreeEntries.Add(EntryIndex);
+	}
+}
+
+bool UPlatformMoverSubsystem::SamplePlatform(const AFloatingPlatform* Platform, float Time, FVector& OutLocation) const
+{
+	const int32* EntryIndex = EntryIndices.Find(Platform);
+	if (!EntryIndex) return false;
+
+	bool bMoving;
+	float SegmentEnd;
+	OutLocation = Entries[*EntryIndex].Motion.Evaluate(Time, bMoving, SegmentEnd);
+	return true;
+}
+
+void UPlatformMoverSubsystem::UpdatePlatforms()
+{
+	const float Now = GetWorld()->GetTimeSeconds();
+
+	UpdateSerial++;
+
+	TArray<int32> Updating;
+	Updating.Reserve(Moving.Num());
+
+	auto Queue = [this, &Updating](int32 EntryIndex)
+	{
+		FMoverEntry& Entry = Entries[EntryIndex];
+
+		if (Entry.QueuedSerial != UpdateSerial)
+		{
+			Entry.QueuedSerial = UpdateSerial;
+			Updating.Add(EntryIndex);
+		}
+	};
+
+	for (int32 EntryIndex : Moving)
+	{
+		Queue(EntryIndex);
+	}
+	Moving.Reset();
+
+	while (Sleeping.Num() > 0 && Sleeping.HeapTop().WakeTime <= Now)
+	{
+		FSleeper Sleeper;
+		Sleeping.HeapPop(Sleeper, false);
+		Queue(Sleeper.Entry);
+	}
+
+	for (int32 EntryIndex : Updating)
+	{
+		UpdateEntry(EntryIndex, Now);
+	}
+}
+
+void UPlatformMoverSubsystem::UpdateEntry(int32 EntryIndex, float Time)
+{
+	FMoverEntry& Entry = Entries[EntryIndex];
+	AFloatingPlatform* Platform = Entry.Platform.Get();
+	if (!Platform) return;
+
+	bool bMoving;
+	float SegmentEnd;
+	const FVector Location = Entry.Motion.Evaluate(Time, bMoving, SegmentEnd); /// resting returns the end point exactly
+
+	if (!Platform->GetActorLocation().Equals(Location, KINDA_SMALL_NUMBER))
+	{
+		Platform->SetActorLocation(Location);
+	}
+	Platform->bInterping = bMoving;
+
+	if (bMoving)
+	{
+		Moving.Add(EntryIndex); /// UpdatePlatforms drops the duplicates Register can add
+	} else
+	{
+		Sleeping.HeapPush(FSleeper{ SegmentEnd, EntryIndex });
+	}
+}
\ No newline at end of file
@@ -0,0 +1,115 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/EngineBaseTypes.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "PlatformMoverSubsystem.generated.h"
+
+/**
+ * Closed-form motion of one platform: rest at A, ease to B, rest at B, ease back to A, repeat
+ * The easing is the continuous form of VInterpTo, the remaining distance shrinks by exp(-InterpSpeed * t)
+ * until it's under 1 unit, so the position at any time is known without simulating the frames before it
+ */
+struct FPlatformMotion
+{
+	FVector PointA = FVector::ZeroVector;
+	FVector PointB = FVector::ZeroVector;
+	float InterpSpeed = 0.f;
+	float PauseTime = 0.f;
+	float MoveTime = 0.f;
+	float StartTime = 0.f;
+
+	void Init(const FVector& A, const FVector& B, float InInterpSpeed, float InPauseTime, float InStartTime);
+
+	/// Location at Time, bOutMoving tells if it's easing or resting and OutSegmentEnd when that ends
+	FVector Evaluate(float Time, bool& bOutMoving, float& OutSegmentEnd) const;
+};
+
+USTRUCT()
+struct FPlatformMoverTickFunction: public FTickFunction
+{
+	GENERATED_BODY()
+
+	class UPlatformMoverSubsystem* Mover = nullptr;
+
+	virtual void ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent) override;
+
+	virtual FString DiagnosticMessage() override { return TEXT("FPlatformMoverTickFunction"); }
+};
+
+template<>
+struct TStructOpsTypeTraits<FPlatformMoverTickFunction>: public TStructOpsTypeTraitsBase2<FPlatformMoverTickFunction>
+{
+	enum { WithCopy = false };
+};
+
+/**
+ * Moves every AFloatingPlatform in one pass before physics so characters standing on them follow the same frame
+ * Resting platforms sleep in a wake-time heap and cost nothing until their pause ends
+ */
+UCLASS()
+class MYFIRSTPROJECT_API UPlatformMoverSubsystem: public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+
+	virtual void Deinitialize() override;
+
+	void Register(class AFloatingPlatform* Platform, const FPlatformMotion& Motion);
+
+	void Unregister(AFloatingPlatform* Platform);
+
+	/// Where Platform is at any world time, past or future, for replays and prediction
+	bool SamplePlatform(const AFloatingPlatform* Platform, float Time, FVector& OutLocation) const;
+
+	/// Move the platforms whose motion is running, wake the ones whose pause is over
+	void UpdatePlatforms();
+
+	FORCEINLINE int32 NumMoving() const { return Moving.Num(); }
+
+private:
+
+	struct FMoverEntry
+	{
+		TWeakObjectPtr<AFloatingPlatform> Platform;
+		FPlatformMotion Motion;
+
+		/// UpdateSerial of the last pass that queued it, an entry reached from Moving and from the heap updates once
+		uint32 QueuedSerial = 0;
+	};
+
+	struct FSleeper
+	{
+		float WakeTime;
+		int32 Entry;
+
+		bool operator<(const FSleeper& Other) const { return WakeTime < Other.WakeTime; }
+	};
+
+	/// place the platform where its motion says and file it as moving or sleeping
+	void UpdateEntry(int32 EntryIndex, float Time);
+
+	TArray<FMoverEntry> Entries;
+
+	/// entry of every registered platform
+	TMap<const AFloatingPlatform*, int32> EntryIndices;
+
+	/// slots of unregistered platforms
+	TArray<int32> FreeEntries;
+
+	/// counts UpdatePlatforms passes
+	uint32 UpdateSerial = 0;
+
+	/// entries easing this frame
+	TArray<int32> Moving;
+
+	/// resting entries, earliest wake time on top
+	TArray<FSleeper> Sleeping;
+
+	FPlatformMoverTickFunction TickFunction;
+};
@@ -0,0 +1,218 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "SaveGameSubsystem.h"
+#include "Async/Async.h"
+#include "Kismet/GameplayStatics.h"
+#include "Misc/Compression.h"
+#include "PlatformFeatures.h"
+#include "SaveGameSystem.h"
+#include "Serialization/BufferArchive.h"
+#include "Serialization/MemoryReader.h"
+
+namespace CharacterSaveFormat
+{
+	/// 'CHSV', lets LoadCharacterStats tell our files from USaveGame ones
+	constexpr uint32 Magic = 0x43485356;
+	constexpr int32 Version = 1;
+}
+
+void USaveGameSubsystem::Deinitialize()
+{
+	if (SaveTask.IsValid())
+	{
+		SaveTask.Wait(); /// never leave a half-written save behind
+	}
+
+	/// FinishSave goes through the game thread and won't start the waiting requests anymore, write them now
+	while (QueuedSaves.Num() > 0)
+	{
+		FPendingSave Next = MoveTemp(QueuedSaves[0]);
+		QueuedSaves.RemoveAt(0);
+		StartSave(MoveTemp(Next));
+
+		if (SaveTask.IsValid())
+		{
+			SaveTask.Wait();
+		}
+	}
+
+	Super::Deinitialize();
+}
+
+void USaveGameSubsystem::SaveCharacterStatsAsync(const FCharacterStats& Snapshot, const FString& SlotName, int32 UserIndex)
+{
+	FPendingSave Save;
+	Save.Snapshot = Snapshot;
+	Save.SlotName = SlotName;
+	Save.UserIndex = UserIndex;
+	Save.RequestTime = FPlatformTime::Seconds();
+
+	if (bSaveInFlight)
+	{
+		/// only the newest state of a slot matters
+		FPendingSave* Queued = QueuedSaves.FindByPredicate([&Save](const FPendingSave& Pending)
+		{
+			return Pending.SlotName == Save.SlotName && Pending.UserIndex == Save.UserIndex;
+		});
+
+		if (Queued)
+		{
+			*Queued = MoveTemp(Save);
+		} else
+		{
+			QueuedSaves.Add(MoveTemp(Save));
+		}
+		return;
+	}
+
+	StartSave(MoveTemp(Save));
+}
+
+void USaveGameSubsystem::StartSave(FPendingSave&& Save)
+{
+	const double GameThreadStart = FPlatformTime::Seconds();
+
+	ISaveGameSystem* SaveSystem = IPlatformFeaturesModule::Get().GetSaveGameSystem();
+	if (!SaveSystem)
+	{
+		FinishSave(false, FAsyncSaveTimings(), Save.RequestTime);
+		return;
+	}
+
+	bSaveInFlight = true;
+	InFlightSave = Save;
+
+	TWeakObjectPtr<USaveGameSubsystem> WeakThis(this);
+	const double RequestTime = Save.RequestTime;
+
+	FAsyncSaveTimings Timings;
+	Timings.GameThreadMs = (FPlatformTime::Seconds() - GameThreadStart) * 1000.0;
+
+	SaveTask = Async(EAsyncExecution::ThreadPool, [WeakThis, SaveSystem, Save = MoveTemp(Save), Timings, RequestTime]() mutable
+	{
+		/// serialize
+		double PhaseStart = FPlatformTime::Seconds();
+
+		FBufferArchive Payload;
+		Payload << Save.Snapshot;
+
+		Timings.SerializeMs = (FPlatformTime::Seconds() - PhaseStart) * 1000.0;
+		Timings.UncompressedBytes = Payload.Num();
+
+		/// compress
+		PhaseStart = FPlatformTime::Seconds();
+
+		int32 CompressedSize = FCompression::CompressMemoryBound(NAME_Zlib, Payload.Num());
+		TArray<uint8> Compressed;
+		Compressed.SetNumUninitialized(CompressedSize);
+
+		bool bSuccess = FCompression::CompressMemory(NAME_Zlib, Compressed.GetData(), CompressedSize, Payload.GetData(), Payload.Num());
+		Compressed.SetNum(CompressedSize, false);
+
+		FBufferArchive File;
+		uint32 Magic = CharacterSaveFormat::Magic;
+		int32 Version = CharacterSaveFormat::Version;
+		int32 UncompressedSize = Payload.Num();
+		File << Magic;
+		File << Version;
+		File << UncompressedSize;
+		File.Append(Compressed);
+
+		Timings.CompressMs = (FPlatformTime::Seconds() - PhaseStart) * 1000.0;
+		Timings.CompressedBytes = File.Num();
+
+		/// write
+		PhaseStart = FPlatformTime::Seconds();
+
+		bSuccess = bSuccess && SaveSystem->SaveGame(false, *Save.SlotName, Save.UserIndex, File);
+
+		Timings.WriteMs = (FPlatformTime::Seconds() - PhaseStart) * 1000.0;
+
+		AsyncTask(ENamedThreads::GameThread, [WeakThis, bSuccess, Timings, RequestTime]()
+		{
+			if (USaveGameSubsystem* This = WeakThis.Get())
+			{
+				This->FinishSave(bSuccess, Timings, RequestTime);
+			}
+		});
+	});
+}
+
+void USaveGameSubsystem::FinishSave(bool bSuccess, FAsyncSaveTimings Timings, double RequestTime)
+{
+	Timings.TotalMs = (FPlatformTime::Seconds() - RequestTime) * 1000.0;
+
+	bSaveInFlight = false;
+	InFlightSave.Reset();
+	LastTimings = Timings;
+
+	UE_LOG(LogTemp, Log, TEXT("SaveGame %s: game thread %.3fms, serialize %.3fms, compress %.3fms, write %.3fms, total %.3fms (%d -> %d bytes)"),
+		bSuccess ? TEXT("done") : TEXT("FAILED"), Timings.GameThreadMs, Timings.SerializeMs, Timings.CompressMs, Timings.WriteMs, Timings.TotalMs,
+		Timings.UncompressedBytes, Timings.CompressedBytes);
+
+	OnSaveCompleted.Broadcast(bSuccess, Timings);
+
+	if (QueuedSaves.Num() > 0)
+	{
+		FPendingSave Next = MoveTemp(QueuedSaves[0]);
+		QueuedSaves.RemoveAt(0);
+		StartSave(MoveTemp(Next));
+	}
+}
+
+bool USaveGameSubsystem::LoadCharacterStats(const FString& SlotName, int32 UserIndex, FCharacterStats& OutStats)
+{
+	/// what the player just saved may not be on disk yet, the newest request wins
+	for (const FPendingSave& Pending : QueuedSaves)
+	{
+		if (Pending.SlotName == SlotName && Pending.UserIndex == UserIndex)
+		{
+			OutStats = Pending.Snapshot;
+			return true;
+		}
+	}
+	if (InFlightSave.IsSet() && InFlightSave->SlotName == SlotName && InFlightSave->UserIndex == UserIndex)
+	{
+		OutStats = InFlightSave->Snapshot;
+		return true;
+	}
+
+	ISaveGameSystem* SaveSystem = IPlatformFeaturesModule::Get().GetSaveGameSystem();
+	TArray<uint8> File;
+
+	if (!SaveSystem || !SaveSystem->LoadGame(false, *SlotName, UserIndex, File)) return false;
+
+	FMemoryReader Reader(File);
+	uint32 Magic = 0;
+	int32 Version = 0;
+	int32 UncompressedSize = 0;
+
+	if (File.Num() >= 12)
+	{
+		Reader << Magic;
+		Reader << Version;
+		Reader << UncompressedSize;
+	}
+
+	if (Magic != CharacterSaveFormat::Magic) /// saved by the old synchronous USaveGame path
+	{
+		UFirstSaveGame* LegacySave = Cast<UFirstSaveGame>(UGameplayStatics::LoadGameFromSlot(SlotName, UserIndex));
+		if (!LegacySave) return false;
+
+		OutStats = LegacySave->CharacterStats;
+		return true;
+	}
+
+	if (Version > CharacterSaveFormat::Version || UncompressedSize <= 0) return false;
+
+	TArray<uint8> Payload;
+	Payload.SetNumUninitialized(UncompressedSize);
+
+	const int32 HeaderSize = Reader.Tell();
+	if (!FCompression::UncompressMemory(NAME_Zlib, Payload.GetData(), UncompressedSize, File.GetData() + HeaderSize, File.Num() - HeaderSize)) return false;
+
+	FMemoryReader PayloadReader(Payload);
+	PayloadReader << OutStats;
+
+	return !PayloadReader.IsError();
+}
\ No newline at end of file
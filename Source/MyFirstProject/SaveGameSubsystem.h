@@ -0,0 +1,103 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "Async/Future.h"
+#include "FirstSaveGame.h"
+#include "SaveGameSubsystem.generated.h"
+
+/// Time spent in each phase of one asynchronous save
+USTRUCT(BlueprintType)
+struct FAsyncSaveTimings
+{
+	GENERATED_BODY()
+
+	/// time the game thread spent starting the save (snapshot copy and dispatch)
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "SaveGame")
+		float GameThreadMs = 0.f;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "SaveGame")
+		float SerializeMs = 0.f;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "SaveGame")
+		float CompressMs = 0.f;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "SaveGame")
+		float WriteMs = 0.f;
+
+	/// from the save request to the completion delegate, including time waiting behind a previous save
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "SaveGame")
+		float TotalMs = 0.f;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "SaveGame")
+		int32 UncompressedBytes = 0;
+
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "SaveGame")
+		int32 CompressedBytes = 0;
+};
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnAsyncSaveCompleted, bool, bSuccess, const FAsyncSaveTimings&, Timings);
+
+/**
+ * Saves the character stats without hitching: the game thread only copies a snapshot, serialization, compression and disk write run on a worker
+ */
+UCLASS()
+class MYFIRSTPROJECT_API USaveGameSubsystem: public UGameInstanceSubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	/// Broadcast on the game thread once a save reached the disk (or failed)
+	UPROPERTY(BlueprintAssignable, Category = "SaveGame")
+		FOnAsyncSaveCompleted OnSaveCompleted;
+
+	virtual void Deinitialize() override;
+
+	/**
+	* Start saving a snapshot of the stats
+	* If a save is already running the snapshot waits for it, a newer request for the same slot replaces a waiting one so saves never overlap
+	*/
+	void SaveCharacterStatsAsync(const FCharacterStats& Snapshot, const FString& SlotName, int32 UserIndex);
+
+	/**
+	* Read stats from a slot written by the async pipeline or by the old USaveGame path
+	* A save of the slot that is still waiting or being written is returned from memory, the file would be older
+	*/
+	bool LoadCharacterStats(const FString& SlotName, int32 UserIndex, FCharacterStats& OutStats);
+
+	UFUNCTION(BlueprintPure, Category = "SaveGame")
+		bool IsSaveInProgress() const { return bSaveInFlight; }
+
+	UFUNCTION(BlueprintPure, Category = "SaveGame")
+		FAsyncSaveTimings GetLastTimings() const { return LastTimings; }
+
+private:
+
+	struct FPendingSave
+	{
+		FCharacterStats Snapshot;
+		FString SlotName;
+		int32 UserIndex;
+		double RequestTime;
+	};
+
+	void StartSave(FPendingSave&& Save);
+
+	/// back on the game thread after the worker finished
+	void FinishSave(bool bSuccess, FAsyncSaveTimings Timings, double RequestTime);
+
+	bool bSaveInFlight = false;
+
+	/// latest request per slot and user made while a save was running, oldest first
+	TArray<FPendingSave> QueuedSaves;
+
+	/// the save the worker is writing, until FinishSave
+	TOptional<FPendingSave> InFlightSave;
+
+	TFuture<void> SaveTask;
+
+	FAsyncSaveTimings LastTimings;
+};
@@ -0,0 +1,240 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "SpatialGridSubsystem.h"
+#include "GameFramework/Actor.h"
+
+USpatialGridSubsystem::USpatialGridSubsystem()
+{
+	CellSize = 500.f;
+}
+
+void USpatialGridSubsystem::Deinitialize()
+{
+	Entries.Empty();
+	EntryIndices.Empty();
+	Cells.Empty();
+
+	Super::Deinitialize();
+}
+
+void USpatialGridSubsystem::Tick(float DeltaTime)
+{
+	for (int32 Index = Entries.Num() - 1; Index >= 0; Index--) /// backwards so removing stale entries doesn't skip any
+	{
+		FEntry& Entry = Entries[Index];
+
+		if (!Entry.bMovable) continue;
+
+		AActor* Actor = Entry.Actor.Get();
+
+		if (!Actor) /// destroyed without unregistering
+		{
+			RemoveEntry(Index);
+			continue;
+		}
+
+		const FVector Location = Actor->GetActorLocation();
+		if (Location != Entry.Location)
+		{
+			MoveEntry(Index, Location);
+		}
+	}
+}
+
+TStatId USpatialGridSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(USpatialGridSubsystem, STATGROUP_Tickables);
+}
+
+void USpatialGridSubsystem::Register(AActor* Actor, ESpatialGridCategory Category, bool bMovable)
+{
+	if (!Actor) return;
+
+	if (int32* Existing = EntryIndices.Find(Actor))
+	{
+		Entries[*Existing].Category = Category;
+		Entries[*Existing].bMovable = bMovable;
+		MoveEntry(*Existing, Actor->GetActorLocation());
+		return;
+	}
+
+	FEntry Entry;
+	Entry.Actor = Actor;
+	Entry.Key = Actor;
+	Entry.Location = Actor->GetActorLocation();
+	Entry.Cell = GetCell(Entry.Location);
+	Entry.Category = Category;
+	Entry.bMovable = bMovable;
+
+	const int32 Index = Entries.Add(Entry);
+	EntryIndices.Add(Actor, Index);
+	Cells.FindOrAdd(Entry.Cell).Add(Index);
+}
+
+void USpatialGridSubsystem::Unregister(AActor* Actor)
+{
+	if (const int32* Index = EntryIndices.Find(Actor))
+	{
+		RemoveEntry(*Index);
+	}
+}
+
+void USpatialGridSubsystem::UpdateActor(AActor* Actor)
+{
+	if (const int32* Index = EntryIndices.Find(Actor))
+	{
+		MoveEntry(*Index, Actor->GetActorLocation());
+	}
+}
+
+void USpatialGridSubsystem::MoveEntry(int32 Index, const FVector& Location)
+{
+	FEntry& Entry = Entries[Index];
+	Entry.Location = Location;
+
+	const FIntPoint NewCell = GetCell(Location);
+	if (NewCell == Entry.Cell) return;
+
+	if (TArray<int32>* OldCell = Cells.Find(Entry.Cell))
+	{
+		OldCell->RemoveSingleSwap(Index, false);
+	}
+	Cells.FindOrAdd(NewCell).Add(Index);
+	Entry.Cell = NewCell;
+}
+
+void USpatialGridSubsystem::RemoveEntry(int32 Index)
+{
+	const FEntry& Removed = Entries[Index];
+
+	if (TArray<int32>* Cell = Cells.Find(Removed.Cell))
+	{
+		Cell->RemoveSingleSwap(Index, false);
+	}
+	EntryIndices.Remove(Removed.Key);
+
+	/// the last entry takes the removed slot, patch its index in the cell and lookup map
+	const int32 LastIndex = Entries.Num() - 1;
+	if (Index != LastIndex)
+	{
+		const FEntry& Last = Entries[LastIndex];
+
+		if (TArray<int32>* Cell = Cells.Find(Last.Cell))
+		{
+			const int32 Slot = Cell->Find(LastIndex);
+			if (Slot != INDEX_NONE) (*Cell)[Slot] = Index;
+		}
+		if (int32* LastEntryIndex = EntryIndices.Find(Last.Key))
+		{
+			*LastEntryIndex = Index;
+		}
+	}
+	Entries.RemoveAtSwap(Index, 1, false);
+}
+
+template<typename VisitorType>
+void USpatialGridSubsystem::ForEachInRange(const FVector& Center, float Radius, uint8 CategoryMask, VisitorType&& Visitor) const
+{
+	const FIntPoint MinCell = GetCell(Center - FVector(Radius));
+	const FIntPoint MaxCell = GetCell(Center + FVector(Radius));
+
+	for (int32 X = MinCell.X; X <= MaxCell.X; X++)
+	{
+		for (int32 Y = MinCell.Y; Y <= MaxCell.Y; Y++)
+		{
+			const TArray<int32>* Cell = Cells.Find(FIntPoint(X, Y));
+			if (!Cell) continue;
+
+			for (int32 Index : *Cell)
+			{
+				const FEntry& Entry = Entries[Index];
+
+				if (CategoryMask & SpatialGridMask::Make(Entry.Category))
+				{
+					Visitor(Entry);
+				}
+			}
+		}
+	}
+}
+
+int32 USpatialGridSubsystem::QueryRadius(const FVector& Center, float Radius, uint8 CategoryMask, TArray<AActor*>& OutActors, TFunctionRef<bool(AActor*)> Filter) const
+{
+	OutActors.Reset();
+	const float RadiusSquared = Radius * Radius;
+
+	ForEachInRange(Center, Radius, CategoryMask, [&](const FEntry& Entry)
+	{
+		if (FVector::DistSquared(Entry.Location, Center) <= RadiusSquared)
+		{
+			AActor* Actor = Entry.Actor.Get();
+			if (Actor && Filter(Actor))
+			{
+				OutActors.Add(Actor);
+			}
+		}
+	});
+
+	return OutActors.Num();
+}
+
+int32 USpatialGridSubsystem::QueryNearest(const FVector& Center, float MaxRadius, int32 Count, uint8 CategoryMask, TArray<AActor*>& OutActors, TFunctionRef<bool(AActor*)> Filter) const
+{
+	OutActors.Reset();
+	if (Count <= 0) return 0;
+
+	const float RadiusSquared = MaxRadius * MaxRadius;
+
+	/// sorted by distance, only the Count best are kept /// stays on the stack for small counts
+	TArray<TPair<float, AActor*>, TInlineAllocator<16>> Best;
+
+	ForEachInRange(Center, MaxRadius, CategoryMask, [&](const FEntry& Entry)
+	{
+		const float DistanceSquared = FVector::DistSquared(Entry.Location, Center);
+
+		if (DistanceSquared > RadiusSquared) return;
+		if (Best.Num() == Count && DistanceSquared >= Best.Last().Key) return;
+
+		AActor* Actor = Entry.Actor.Get();
+		if (!Actor || !Filter(Actor)) return;
+
+		int32 Insert = Best.Num();
+		while (Insert > 0 && Best[Insert - 1].Key > DistanceSquared)
+		{
+			Insert--;
+		}
+
+		if (Best.Num() == Count) Best.Pop(false);
+		Best.Insert(TPair<float, AActor*>(DistanceSquared, Actor), Insert);
+	});
+
+	for (const TPair<float, AActor*>& Pair : Best)
+	{
+		OutActors.Add(Pair.Value);
+	}
+
+	return OutActors.Num();
+}
+
+AActor* USpatialGridSubsystem::FindNearest(const FVector& Center, float MaxRadius, uint8 CategoryMask, TFunctionRef<bool(AActor*)> Filter) const
+{
+	AActor* Nearest = nullptr;
+	float NearestDistanceSquared = MaxRadius * MaxRadius;
+
+	ForEachInRange(Center, MaxRadius, CategoryMask, [&](const FEntry& Entry)
+	{
+		const float DistanceSquared = FVector::DistSquared(Entry.Location, Center);
+
+		if (DistanceSquared <= NearestDistanceSquared)
+		{
+			AActor* Actor = Entry.Actor.Get();
+			if (Actor && Filter(Actor))
+			{
+				Nearest = Actor;
+				NearestDistanceSquared = DistanceSquared;
+			}
+		}
+	});
+
+	return Nearest;
+}
\ No newline at end of file
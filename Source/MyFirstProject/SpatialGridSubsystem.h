@@ -0,0 +1,112 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "TickableGameplaySubsystem.h"
+#include "SpatialGridSubsystem.generated.h"
+
+/// What kind of actor an entry of the spatial grid is
+UENUM(BlueprintType)
+enum class ESpatialGridCategory: uint8
+{
+	ESGC_Enemy		UMETA(DisplayName = "Enemy"),
+	ESGC_Item		UMETA(DisplayName = "Item"),
+	ESGC_Spawner	UMETA(DisplayName = "Spawner"),
+
+	ESGC_MAX		UMETA(DisplayName = "DefaultMax")
+};
+
+/// Bit mask built from ESpatialGridCategory values to filter queries
+namespace SpatialGridMask
+{
+	constexpr uint8 Make(ESpatialGridCategory Category) { return 1 << static_cast<uint8>(Category); }
+
+	constexpr uint8 Enemy = Make(ESpatialGridCategory::ESGC_Enemy);
+	constexpr uint8 Item = Make(ESpatialGridCategory::ESGC_Item);
+	constexpr uint8 Spawner = Make(ESpatialGridCategory::ESGC_Spawner);
+	constexpr uint8 All = Enemy | Item | Spawner;
+}
+
+/**
+ * Uniform spatial hash (XY cells) of live enemies, items and spawners for cheap proximity queries
+ */
+UCLASS()
+class MYFIRSTPROJECT_API USpatialGridSubsystem: public UTickableGameplaySubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	USpatialGridSubsystem();
+
+	/// Size of one grid cell in world units, should be in the range of the usual query radius
+	float CellSize;
+
+	virtual void Deinitialize() override;
+
+	/// re-bucket movable entries whose actor changed cell since last frame
+	virtual void Tick(float DeltaTime) override;
+
+	virtual TStatId GetStatId() const override;
+
+	/// Add an actor to the grid /// movable actors are refreshed every frame, static ones only through UpdateActor
+	void Register(AActor* Actor, ESpatialGridCategory Category, bool bMovable);
+
+	void Unregister(AActor* Actor);
+
+	/// Refresh the stored location of a single actor right away
+	void UpdateActor(AActor* Actor);
+
+	/**
+	* Collect every actor of the masked categories within Radius of Center
+	* @Param OutActors is reset but keeps its allocation, reuse the same array to avoid allocating per call
+	*/
+	int32 QueryRadius(const FVector& Center, float Radius, uint8 CategoryMask, TArray<AActor*>& OutActors, TFunctionRef<bool(AActor*)> Filter = [](AActor*) { return true; }) const;
+
+	/**
+	* Collect up to Count actors closest to Center within MaxRadius, sorted by distance
+	* @Param OutActors is reset but keeps its allocation, reuse the same array to avoid allocating per call
+	*/
+	int32 QueryNearest(const FVector& Center, float MaxRadius, int32 Count, uint8 CategoryMask, TArray<AActor*>& OutActors, TFunctionRef<bool(AActor*)> Filter = [](AActor*) { return true; }) const;
+
+	/// Closest actor of the masked categories within MaxRadius or nullptr
+	AActor* FindNearest(const FVector& Center, float MaxRadius, uint8 CategoryMask, TFunctionRef<bool(AActor*)> Filter = [](AActor*) { return true; }) const;
+
+	FORCEINLINE int32 Num() const { return Entries.Num(); }
+
+private:
+
+	struct FEntry
+	{
+		TWeakObjectPtr<AActor> Actor;
+		const AActor* Key; /// lookup key only, never dereferenced
+		FVector Location;
+		FIntPoint Cell;
+		ESpatialGridCategory Category;
+		bool bMovable;
+	};
+
+	FORCEINLINE FIntPoint GetCell(const FVector& Location) const
+	{
+		return FIntPoint(FMath::FloorToInt(Location.X / CellSize), FMath::FloorToInt(Location.Y / CellSize));
+	}
+
+	/// move entry Index from its current cell to the one of Location
+	void MoveEntry(int32 Index, const FVector& Location);
+
+	void RemoveEntry(int32 Index);
+
+	/// call Visitor on every entry whose cell overlaps the square around Center
+	template<typename VisitorType>
+	void ForEachInRange(const FVector& Center, float Radius, uint8 CategoryMask, VisitorType&& Visitor) const;
+
+	/// dense array of entries, removed with swap so indices stay compact
+	TArray<FEntry> Entries;
+
+	/// entry index of each registered actor
+	TMap<const AActor*, int32> EntryIndices;
+
+	/// entry indices stored in each occupied cell
+	TMap<FIntPoint, TArray<int32>> Cells;
+};
@@ -1,85 +1,136 @@
-// Fill out your copyright notice in the Description page of Project Settings.
-
-#include "SpawnVolume.h"
-#include "Components/BoxComponent.h"
-#include "Kismet/KismetMathLibrary.h"
-#include "Engine/World.h"
-#include "Critter.h"
-#include "Enemy.h"
-#include "AIController.h"
-
-// Sets default values
-ASpawnVolume::ASpawnVolume()
-{
-	// Set this actor to call Tick() every frame.  You can turn this off to improve performance if you don't need it.
-	PrimaryActorTick.bCanEverTick = true;
-
-	SpawningBox = CreateAbstractDefaultSubobject<UBoxComponent>(TEXT("SpawningBox"));
-}
-
-// Called when the game starts or when spawned
-void ASpawnVolume::BeginPlay()
-{
-	Super::BeginPlay();
-
-	if (Actor_1 && Actor_2 && Actor_3 && Actor_4)
-	{
-		SpawnArray.Add(Actor_1);
-		SpawnArray.Add(Actor_2);
-		SpawnArray.Add(Actor_3);
-		SpawnArray.Add(Actor_4);
-	}
-}
-
-// Called every frame
-void ASpawnVolume::Tick(float DeltaTime)
-{
-	Super::Tick(DeltaTime);
-}
-
-FVector ASpawnVolume::GetSpawnPoint()
-{
-	FVector Extent = SpawningBox->GetScaledBoxExtent(); /// Wil return the extent (borders) of the box
-	FVector Origin = SpawningBox->GetComponentLocation(); /// will return the origin of the box
-	FVector Point = UKismetMathLibrary::RandomPointInBoundingBox(Origin, Extent); /// Get Random position inside the box extent
-	return Point;
-}
-
-void ASpawnVolume::SpawnOurActor_Implementation(UClass* ToSpawn, const FVector& Location)
-{
-	if (ToSpawn)
-	{
-		UWorld* World = GetWorld();
-
-		FActorSpawnParameters SpawnParams;
-
-		if (World)
-		{
-			AActor* Actor = World->SpawnActor<AActor>(ToSpawn, Location, FRotator(0.0f), SpawnParams);
-			AEnemy* Enemy = Cast<AEnemy>(Actor);
-
-			if (Enemy)
-			{
-				Enemy->SpawnDefaultController();
-
-				AAIController* AICont = Cast<AAIController>(Enemy->GetController());
-				if (AICont)
-				{
-					Enemy->AIController = AICont;
-				}
-			}
-		}
-	}
-}
-
-TSubclassOf<AActor> ASpawnVolume::GetSpawnActor()
-{
-	if (SpawnArray.Num() > 0)
-	{
-		int32 Selection = FMath::FRandRange(0, SpawnArray.Num() - 1);
-		return SpawnArray[Selection];
-	} else
-	{
-		return nullptr;
-	}
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "SpawnVolume.h"
+#include "Components/BoxComponent.h"
+#include "Kismet/KismetMathLibrary.h"
+#include "Engine/World.h"
+#include "Critter.h"
+#include "Enemy.h"
+#include "AIController.h"
+#include "EnemyPoolSubsystem.h"
+#include "SpatialGridSubsystem.h"
+#include "AssetPreloadSubsystem.h"
+#include "GameplayPerf.h"
+#include "CombatTelemetrySubsystem.h"
+#include "TickGovernanceSubsystem.h"
+
+// Sets default values
+ASpawnVolume::ASpawnVolume()
+{
+	// Set this actor to call Tick() every frame.  You can turn this off to improve performance if you don't need it.
+	PrimaryActorTick.bCanEverTick = true;
+	PrimaryActorTick.bStartWithTickEnabled = false; /// nothing to do per frame natively, only a Blueprint Event Tick needs this
+
+	SpawningBox = CreateAbstractDefaultSubobject<UBoxComponent>(TEXT("SpawningBox"));
+
+	PoolPrewarmCount = 4;
+}
+
+// Called when the game starts or when spawned
+void ASpawnVolume::BeginPlay()
+{
+	Super::BeginPlay();
+
+	SetActorTickEnabled(UTickGovernanceSubsystem::HasBlueprintTick(this));
+
+	if (Actor_1 && Actor_2 && Actor_3 && Actor_4)
+	{
+		SpawnArray.Add(Actor_1);
+		SpawnArray.Add(Actor_2);
+		SpawnArray.Add(Actor_3);
+		SpawnArray.Add(Actor_4);
+	}
+
+	if (USpatialGridSubsystem* SpatialGrid = GetWorld()->GetSubsystem<USpatialGridSubsystem>())
+	{
+		SpatialGrid->Register(this, ESpatialGridCategory::ESGC_Spawner, false);
+	}
+	if (UAssetPreloadSubsystem* Preload = GetWorld()->GetSubsystem<UAssetPreloadSubsystem>()) /// streams in what this volume spawns once the player comes close
+	{
+		Preload->RegisterSpawner(this);
+	}
+
+	UEnemyPoolSubsystem* Pool = GetWorld()->GetSubsystem<UEnemyPoolSubsystem>();
+
+	if (Pool && PoolPrewarmCount > 0) /// create the enemies now so spawning later doesn't hitch
+	{
+		for (const TSubclassOf<AActor>& SpawnClass : SpawnArray)
+		{
+			if (SpawnClass && SpawnClass->IsChildOf(AEnemy::StaticClass()))
+			{
+				Pool->Prewarm(*SpawnClass, PoolPrewarmCount, GetActorLocation());
+			}
+		}
+	}
+}
+
+void ASpawnVolume::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (USpatialGridSubsystem* SpatialGrid = GetWorld()->GetSubsystem<USpatialGridSubsystem>())
+	{
+		SpatialGrid->Unregister(this);
+	}
+	if (UAssetPreloadSubsystem* Preload = GetWorld()->GetSubsystem<UAssetPreloadSubsystem>())
+	{
+		Preload->UnregisterSpawner(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
+// Called every frame
+void ASpawnVolume::Tick(float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+}
+
+FVector ASpawnVolume::GetSpawnPoint()
+{
+	FVector Extent = SpawningBox->GetScaledBoxExtent(); /// Wil return the extent (borders) of the box
+	FVector Origin = SpawningBox->GetComponentLocation(); /// will return the origin of the box
+	FVector Point = UKismetMathLibrary::RandomPointInBoundingBox(Origin, Extent); /// Get Random position inside the box extent
+	return Point;
+}
+
+void ASpawnVolume::SpawnOurActor_Implementation(UClass* ToSpawn, const FVector& Location)
+{
+	GAMEPLAY_PERF_SCOPE(SpawnOurActor);
+
+	if (ToSpawn)
+	{
+		GAMEPLAY_PERF_COUNT_SPAWN();
+
+		UWorld* World = GetWorld();
+
+		FActorSpawnParameters SpawnParams;
+
+		if (World)
+		{
+			UEnemyPoolSubsystem* Pool = World->GetSubsystem<UEnemyPoolSubsystem>();
+
+			if (Pool && ToSpawn->IsChildOf(AEnemy::StaticClass())) /// enemies come from the pool, it spawns their controller on a miss
+			{
+				AEnemy* Enemy = Pool->Acquire(ToSpawn, Location, FRotator(0.0f));
+
+				UCombatTelemetrySubsystem::Record(this, ECombatTraceEvent::Spawn, Location, Enemy);
+				return;
+			}
+
+			AActor* Actor = World->SpawnActor<AActor>(ToSpawn, Location, FRotator(0.0f), SpawnParams);
+
+			UCombatTelemetrySubsystem::Record(this, ECombatTraceEvent::Spawn, Location, Actor);
+		}
+	}
+}
+
+TSubclassOf<AActor> ASpawnVolume::GetSpawnActor()
+{
+	if (SpawnArray.Num() > 0)
+	{
+		int32 Selection = FMath::FRandRange(0, SpawnArray.Num() - 1);
+		return SpawnArray[Selection];
+	} else
+	{
+		return nullptr;
+	}
 }
\ No newline at end of file
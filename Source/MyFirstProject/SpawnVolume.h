@@ -1,55 +1,62 @@
-// Fill out your copyright notice in the Description page of Project Settings.
-
-#pragma once
-
-#include "CoreMinimal.h"
-#include "GameFramework/Actor.h"
-#include "SpawnVolume.generated.h"
-
-UCLASS()
-class MYFIRSTPROJECT_API ASpawnVolume: public AActor
-{
-	GENERATED_BODY()
-
-public:
-	// Sets default values for this actor's properties
-	ASpawnVolume();
-
-	/// Empty Box Component to spawn critter inside
-	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = Spawning)
-		class UBoxComponent* SpawningBox;
-
-	/// Variable that contains a blueprint
-	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Spawning)
-		TSubclassOf<AActor> Actor_1;
-
-	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Spawning)
-		TSubclassOf<AActor> Actor_2;
-
-	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Spawning)
-		TSubclassOf<AActor> Actor_3;
-
-	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Spawning)
-		TSubclassOf<AActor> Actor_4;
-
-	TArray<TSubclassOf<AActor>> SpawnArray;
-
-protected:
-	// Called when the game starts or when spawned
-	virtual void BeginPlay() override;
-
-public:
-	// Called every frame
-	virtual void Tick(float DeltaTime) override;
-
-	/// Get random spawn location on the spawn volume
-	UFUNCTION(BlueprintPure, Category = Spawning)
-		FVector GetSpawnPoint();
-
-	UFUNCTION(BlueprintPure, Category = Spawning)
-		TSubclassOf<AActor> GetSpawnActor();
-
-	/// Spawn Critters in a specific location
-	UFUNCTION(BlueprintNativeEvent, BlueprintCallable, Category = Spawning)
-		void SpawnOurActor(UClass* ToSpawn, const FVector& Location);
-};
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "SpawnVolume.generated.h"
+
+UCLASS()
+class MYFIRSTPROJECT_API ASpawnVolume: public AActor
+{
+	GENERATED_BODY()
+
+public:
+	// Sets default values for this actor's properties
+	ASpawnVolume();
+
+	/// Empty Box Component to spawn critter inside
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = Spawning)
+		class UBoxComponent* SpawningBox;
+
+	/// Variable that contains a blueprint
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Spawning)
+		TSubclassOf<AActor> Actor_1;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Spawning)
+		TSubclassOf<AActor> Actor_2;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Spawning)
+		TSubclassOf<AActor> Actor_3;
+
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Spawning)
+		TSubclassOf<AActor> Actor_4;
+
+	TArray<TSubclassOf<AActor>> SpawnArray;
+
+	/// Number of enemies of each spawnable class to create ahead of time in the enemy pool
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = Spawning)
+		int32 PoolPrewarmCount;
+
+protected:
+	// Called when the game starts or when spawned
+	virtual void BeginPlay() override;
+
+	/// Called when the actor is destroyed or its level is unloaded
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+public:
+	// Called every frame
+	virtual void Tick(float DeltaTime) override;
+
+	/// Get random spawn location on the spawn volume
+	UFUNCTION(BlueprintPure, Category = Spawning)
+		FVector GetSpawnPoint();
+
+	UFUNCTION(BlueprintPure, Category = Spawning)
+		TSubclassOf<AActor> GetSpawnActor();
+
+	/// Spawn Critters in a specific location
+	UFUNCTION(BlueprintNativeEvent, BlueprintCallable, Category = Spawning)
+		void SpawnOurActor(UClass* ToSpawn, const FVector& Location);
+};
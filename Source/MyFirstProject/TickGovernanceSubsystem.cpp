@@ -0,0 +1,202 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "TickGovernanceSubsystem.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "GameFramework/Actor.h"
+
+bool UTickGovernanceSubsystem::bSampling = false;
+
+static FAutoConsoleCommandWithWorldAndArgs TickReportCommand(
+	TEXT("Tick.Report"),
+	TEXT("List actors per class with their tick state, interval and measured tick cost, optional number of frames to sample (default 60)"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, UWorld* World)
+{
+	if (World)
+	{
+		if (UTickGovernanceSubsystem* TickGovernance = World->GetSubsystem<UTickGovernanceSubsystem>())
+		{
+			TickGovernance->StartReport(Args.Num() > 0 ? FCString::Atoi(*Args[0]) : 60);
+		}
+	}
+}));
+
+UTickGovernanceSubsystem::UTickGovernanceSubsystem()
+{
+	SampleFrames = 0;
+	SampleFramesLeft = 0;
+}
+
+void UTickGovernanceSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	TickIntervals.Reset();
+	for (const auto& Pair : GetDefault<UTickGovernanceSettings>()->ActorTickIntervals)
+	{
+		if (UClass* Class = Pair.Key.LoadSynchronous()) /// once per level, pooled and spawned later classes may not be loaded yet
+		{
+			TickIntervals.Emplace(Class, FMath::Max(Pair.Value, 0.f));
+		}
+	}
+
+	auto Depth = [](const UClass* Class)
+	{
+		int32 Result = 0;
+		for (; Class; Class = Class->GetSuperClass()) Result++;
+		return Result;
+	};
+	TickIntervals.Sort([&Depth](const TPair<UClass*, float>& A, const TPair<UClass*, float>& B)
+	{
+		return Depth(A.Key) > Depth(B.Key);
+	});
+
+	if (TickIntervals.Num() > 0)
+	{
+		for (TActorIterator<AActor> It(&InWorld); It; ++It)
+		{
+			ApplyTickInterval(*It);
+		}
+	}
+
+	ActorSpawnedHandle = InWorld.AddOnActorSpawnedHandler(FOnActorSpawned::FDelegate::CreateUObject(this, &UTickGovernanceSubsystem::OnActorSpawned));
+}
+
+void UTickGovernanceSubsystem::Deinitialize()
+{
+	if (UWorld* World = GetWorld())
+	{
+		World->RemoveOnActorSpawnedHandler(ActorSpawnedHandle);
+	}
+
+	if (SampleFramesLeft > 0)
+	{
+		bSampling = false;
+	}
+
+	Super::Deinitialize();
+}
+
+void UTickGovernanceSubsystem::OnActorSpawned(AActor* Actor)
+{
+	ApplyTickInterval(Actor);
+}
+
+void UTickGovernanceSubsystem::ApplyTickInterval(AActor* Actor) const
+{
+	if (!Actor || !Actor->PrimaryActorTick.bCanEverTick) return;
+
+	for (const TPair<UClass*, float>& Interval : TickIntervals)
+	{
+		if (Actor->IsA(Interval.Key))
+		{
+			Actor->SetActorTickInterval(Interval.Value);
+			return;
+		}
+	}
+}
+
+bool UTickGovernanceSubsystem::HasBlueprintTick(const AActor* Actor)
+{
+	static const FName ReceiveTickName(TEXT("ReceiveTick"));
+	return Actor && Actor->GetClass()->IsFunctionImplementedInScript(ReceiveTickName);
+}
+
+void UTickGovernanceSubsystem::StartReport(int32 Frames)
+{
+	SampleFrames = FMath::Max(Frames, 1);
+	SampleFramesLeft = SampleFrames;
+	TickCosts.Reset();
+	bSampling = true;
+}
+
+bool UTickGovernanceSubsystem::IsTickable() const
+{
+	return SampleFramesLeft > 0 && Super::IsTickable();
+}
+
+void UTickGovernanceSubsystem::Tick(float DeltaTime)
+{
+	if (--SampleFramesLeft > 0) return;
+
+	bSampling = false;
+	LogReport();
+}
+
+void UTickGovernanceSubsystem::AddTickCost(const AActor* Actor, uint64 Cycles)
+{
+	UTickGovernanceSubsystem* TickGovernance = Actor->GetWorld()->GetSubsystem<UTickGovernanceSubsystem>();
+	if (!TickGovernance) return;
+
+	TPair<uint64, int32>& Cost = TickGovernance->TickCosts.FindOrAdd(Actor->GetClass());
+	Cost.Key += Cycles;
+	Cost.Value++;
+}
+
+void UTickGovernanceSubsystem::LogReport() const
+{
+	struct FClassRow
+	{
+		int32 Actors = 0;
+		int32 CanEverTick = 0;
+		int32 TickEnabled = 0;
+		float MinInterval = BIG_NUMBER;
+		float MaxInterval = 0.f;
+	};
+
+	TMap<UClass*, FClassRow> Rows;
+
+	for (TActorIterator<AActor> It(GetWorld()); It; ++It)
+	{
+		FClassRow& Row = Rows.FindOrAdd(It->GetClass());
+		Row.Actors++;
+
+		if (It->PrimaryActorTick.bCanEverTick)
+		{
+			Row.CanEverTick++;
+		}
+		if (It->IsActorTickEnabled())
+		{
+			Row.TickEnabled++;
+			Row.MinInterval = FMath::Min(Row.MinInterval, It->GetActorTickInterval());
+			Row.MaxInterval = FMath::Max(Row.MaxInterval, It->GetActorTickInterval());
+		}
+	}
+
+	/// most ticking actors first
+	Rows.ValueSort([](const FClassRow& A, const FClassRow& B) { return A.TickEnabled > B.TickEnabled; });
+
+	UE_LOG(LogTemp, Log, TEXT("Tick report over %d frames (cost only for classes instrumented with FTickCostScope):"), SampleFrames);
+	UE_LOG(LogTemp, Log, TEXT("%-40s %7s %9s %8s %14s %10s %12s"), TEXT("Class"), TEXT("Actors"), TEXT("CanTick"), TEXT("Ticking"), TEXT("Interval"), TEXT("Ticks/fr"), TEXT("ms/frame"));
+
+	int32 TotalTicking = 0;
+	double TotalMs = 0.0;
+
+	for (const auto& Pair : Rows)
+	{
+		const FClassRow& Row = Pair.Value;
+		if (Row.CanEverTick == 0) continue;
+
+		FString Interval = TEXT("-");
+		if (Row.TickEnabled > 0)
+		{
+			Interval = Row.MinInterval == Row.MaxInterval ? FString::Printf(TEXT("%.3f"), Row.MinInterval) : FString::Printf(TEXT("%.3f-%.3f"), Row.MinInterval, Row.MaxInterval);
+		}
+
+		FString TicksPerFrame = TEXT("-");
+		FString Cost = TEXT("-");
+		if (const TPair<uint64, int32>* Measured = TickCosts.Find(Pair.Key))
+		{
+			const double Ms = FPlatformTime::ToMilliseconds64(Measured->Key) / SampleFrames;
+			TicksPerFrame = FString::Printf(TEXT("%.1f"), float(Measured->Value) / SampleFrames);
+			Cost = FString::Printf(TEXT("%.4f"), Ms);
+			TotalMs += Ms;
+		}
+
+		TotalTicking += Row.TickEnabled;
+
+		UE_LOG(LogTemp, Log, TEXT("%-40s %7d %9d %8d %14s %10s %12s"), *Pair.Key->GetName(), Row.Actors, Row.CanEverTick, Row.TickEnabled, *Interval, *TicksPerFrame, *Cost);
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("%d actors ticking, %.4f ms/frame measured"), TotalTicking, TotalMs);
+}
\ No newline at end of file
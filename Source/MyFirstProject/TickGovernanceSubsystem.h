@@ -0,0 +1,98 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DeveloperSettings.h"
+#include "TickableGameplaySubsystem.h"
+#include "TickGovernanceSubsystem.generated.h"
+
+/**
+ * Per-class actor tick intervals, Project Settings > Game > Tick Governance
+ */
+UCLASS(config = Game, defaultconfig, meta = (DisplayName = "Tick Governance"))
+class MYFIRSTPROJECT_API UTickGovernanceSettings: public UDeveloperSettings
+{
+	GENERATED_BODY()
+
+public:
+
+	/// Tick interval in seconds for actors of each class, the most derived matching class wins, 0 ticks every frame
+	UPROPERTY(config, EditAnywhere, Category = "Tick")
+		TMap<TSoftClassPtr<AActor>, float> ActorTickIntervals;
+};
+
+/**
+ * Applies the configured tick intervals to every actor of the world and measures tick cost for the Tick.Report command
+ */
+UCLASS()
+class MYFIRSTPROJECT_API UTickGovernanceSubsystem: public UTickableGameplaySubsystem
+{
+	GENERATED_BODY()
+
+public:
+
+	UTickGovernanceSubsystem();
+
+	virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+
+	virtual void Deinitialize() override;
+
+	virtual void Tick(float DeltaTime) override;
+
+	virtual bool IsTickable() const override;
+
+	/// Measure actor tick cost for Frames frames, then log the per-class report
+	void StartReport(int32 Frames);
+
+	/// Actors whose Blueprint implements Event Tick need their tick whatever the native class does
+	static bool HasBlueprintTick(const AActor* Actor);
+
+	static bool IsSampling() { return bSampling; }
+
+	static void AddTickCost(const AActor* Actor, uint64 Cycles);
+
+private:
+
+	void OnActorSpawned(AActor* Actor);
+
+	void ApplyTickInterval(AActor* Actor) const;
+
+	void LogReport() const;
+
+	/// configured classes, most derived first
+	TArray<TPair<UClass*, float>> TickIntervals;
+
+	/// cycles and calls measured per class while sampling
+	TMap<UClass*, TPair<uint64, int32>> TickCosts;
+
+	int32 SampleFrames;
+	int32 SampleFramesLeft;
+
+	FDelegateHandle ActorSpawnedHandle;
+
+	static bool bSampling;
+};
+
+/// Put at the top of an actor Tick so Tick.Report can show what the class costs, free while no report is running
+struct FTickCostScope
+{
+	explicit FTickCostScope(const AActor* InActor)
+		: Actor(UTickGovernanceSubsystem::IsSampling() ? InActor : nullptr)
+		, StartCycles(Actor ? FPlatformTime::Cycles64() : 0)
+	{
+	}
+
+	~FTickCostScope()
+	{
+		if (Actor)
+		{
+			UTickGovernanceSubsystem::AddTickCost(Actor, FPlatformTime::Cycles64() - StartCycles);
+		}
+	}
+
+private:
+
+	const AActor* Actor;
+	uint64 StartCycles;
+};
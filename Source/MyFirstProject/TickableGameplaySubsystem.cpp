@@ -0,0 +1,20 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "TickableGameplaySubsystem.h"
+#include "Engine/World.h"
+
+ETickableTickType UTickableGameplaySubsystem::GetTickableTickType() const
+{
+	return IsTemplate() ? ETickableTickType::Never : ETickableTickType::Conditional;
+}
+
+bool UTickableGameplaySubsystem::IsTickable() const
+{
+	UWorld* World = GetWorld();
+	return !IsTemplate() && World && World->IsGameWorld();
+}
+
+TStatId UTickableGameplaySubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UTickableGameplaySubsystem, STATGROUP_Tickables);
+}
\ No newline at end of file
@@ -0,0 +1,31 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Tickable.h"
+#include "TickableGameplaySubsystem.generated.h"
+
+/**
+ * World subsystem that ticks once per frame in game worlds only, base for the batched gameplay managers
+ */
+UCLASS(Abstract)
+class MYFIRSTPROJECT_API UTickableGameplaySubsystem: public UWorldSubsystem, public FTickableGameObject
+{
+	GENERATED_BODY()
+
+public:
+
+	virtual void Tick(float DeltaTime) override {}
+
+	/// the class default object must never tick
+	virtual ETickableTickType GetTickableTickType() const override;
+
+	/// only tick inside a game world (PIE or standalone), never in the editor world
+	virtual bool IsTickable() const override;
+
+	virtual UWorld* GetTickableGameObjectWorld() const override { return GetWorld(); }
+
+	virtual TStatId GetStatId() const override;
+};
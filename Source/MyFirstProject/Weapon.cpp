@@ -1,153 +1,171 @@
-// Fill out your copyright notice in the Description page of Project Settings.
-
-#include "Weapon.h"
-#include "Main.h"
-#include "Components/SkeletalMeshComponent.h"
-#include "Engine/SkeletalMeshSocket.h"
-#include "Sound/SoundCue.h"
-#include "Kismet/GameplayStatics.h"
-#include "Particles/ParticleSystemComponent.h"
-#include "Components/BoxComponent.h"
-#include "Enemy.h"
-
-AWeapon::AWeapon()
-{
-	SkeletalMesh = CreateDefaultSubobject<USkeletalMeshComponent>(TEXT("SkeletalMesh"));
-	SkeletalMesh->SetupAttachment(GetRootComponent());
-	bWeaponParticles = false;
-	WeaponState = EWeaponState::EWS_Pickup;
-
-	CombatCollision = CreateDefaultSubobject<UBoxComponent>(TEXT("CombatCollision"));
-	CombatCollision->SetupAttachment(GetRootComponent());
-
-	Damage = 25.f;
-}
-
-void AWeapon::BeginPlay()
-{
-	Super::BeginPlay();
-
-	CombatCollision->OnComponentBeginOverlap.AddDynamic(this, &AWeapon::CombatOnOverlapBegin);
-	CombatCollision->OnComponentEndOverlap.AddDynamic(this, &AWeapon::CombatOnOverlapEnd);
-
-	CombatCollision->SetCollisionEnabled(ECollisionEnabled::NoCollision); /// to do not generate overlap events
-	CombatCollision->SetCollisionObjectType(ECollisionChannel::ECC_WorldDynamic); /// automatic overlap parameters set
-	CombatCollision->SetCollisionResponseToAllChannels(ECollisionResponse::ECR_Ignore); /// ignore all channels collision by defaults
-	CombatCollision->SetCollisionResponseToChannel(ECollisionChannel::ECC_Pawn, ECollisionResponse::ECR_Overlap); /// set collision to overlap for for pawn
-}
-
-void AWeapon::OnOverlapBegin(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult)
-{
-	Super::OnOverlapBegin(OverlappedComponent, OtherActor, OtherComp, OtherBodyIndex, bFromSweep, SweepResult);
-
-	if ((WeaponState == EWeaponState::EWS_Pickup) && OtherActor) /// check if the item is valid and save it into the overlapping variable
-	{
-		AMain* Main = Cast<AMain>(OtherActor);
-
-		if (Main)
-		{
-			Main->SetActiveOverlappingItem(this);
-		}
-	}
-}
-
-void AWeapon::OnOverlapEnd(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex)
-{
-	Super::OnOverlapEnd(OverlappedComponent, OtherActor, OtherComp, OtherBodyIndex);
-
-	if (OtherActor) /// check if the item is valid and save it into the overlapping variable
-	{
-		AMain* Main = Cast<AMain>(OtherActor);
-
-		if (Main)
-		{
-			Main->SetActiveOverlappingItem(nullptr); /// remove the item from the variable on leaving the sphere
-		}
-	}
-}
-
-void AWeapon::Equip(AMain* Char)
-{
-	if (Char)
-	{
-		SetInstegator(Char->GetController());
-
-		/// do not let the camera zoom if the sword is between the camera and the player
-		SkeletalMesh->SetCollisionResponseToChannel(ECollisionChannel::ECC_Camera, ECollisionResponse::ECR_Ignore);
-
-		/// disable collision between sword and pawn to let it keep moving
-		SkeletalMesh->SetCollisionResponseToChannel(ECollisionChannel::ECC_Pawn, ECollisionResponse::ECR_Ignore);
-
-		/// disable physics simulatin to attach the weapon to the player
-		SkeletalMesh->SetSimulatePhysics(false);
-
-		/// Get socket by name from engine and attach the USkeletalMeshSocket to it
-		const USkeletalMeshSocket* RightHandsocket = Char->GetMesh()->GetSocketByName("RightHandSocket");
-
-		/// check if the socket is valid and attach the skeletal mesh to it
-		if (RightHandsocket)
-		{
-			RightHandsocket->AttachActor(this, Char->GetMesh());
-			bRotate = false;
-
-			Char->SetEquippedWeapon(this); /// set the new weapon to the selected one
-			Char->SetActiveOverlappingItem(nullptr); /// remove the item from the variable on leaving the sphere
-			WeaponState = EWeaponState::EWS_Equipped; /// set status to equipped to disable overlapping again /// every Weapon_BP has it's own WeaponState, so it won't bug
-		}
-
-		if (OnEquipSound) /// check if equip sound is set to a weapon and play it when player equip it
-		{
-			UGameplayStatics::PlaySound2D(this, OnEquipSound);
-		}
-
-		if (!bWeaponParticles) /// deactivate weapon particles upon equiping /// can be set from the editor to keep particles or no
-		{
-			IdleParticlesComponent->Deactivate();
-		}
-	}
-}
-
-void AWeapon::CombatOnOverlapBegin(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult)
-{
-	if (OtherActor)
-	{
-		AEnemy* Enemy = Cast<AEnemy>(OtherActor);
-
-		if (Enemy)
-		{
-			if (Enemy->HitParticles)
-			{
-				/// Spawn particles on the socket attached to weapon when hitting an enemy
-				const USkeletalMeshSocket* WeaponSocket = SkeletalMesh->GetSocketByName("WeaponSocket");
-				if (WeaponSocket)
-				{
-					FVector SocketLocation = WeaponSocket->GetSocketLocation(SkeletalMesh);
-					UGameplayStatics::SpawnEmitterAtLocation(GetWorld(), Enemy->HitParticles, SocketLocation, FRotator(0.f), false);
-				}
-				/// play hit sound when sword hit the enemy capsule
-				if (Enemy->HitSound)
-				{
-					UGameplayStatics::PlaySound2D(this, Enemy->HitSound);
-				}
-				if (DamageTypeClass)
-				{
-					UGameplayStatics::ApplyDamage(Enemy, Damage, WeaponInstegator, this, DamageTypeClass);
-				}
-			}
-		}
-	}
-}
-
-void AWeapon::CombatOnOverlapEnd(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex)
-{
-}
-
-void AWeapon::ActivateCollision()
-{
-	CombatCollision->SetCollisionEnabled(ECollisionEnabled::QueryOnly); ///  generate overlap events to specific target
-}
-
-void AWeapon::DeActivateCollision()
-{
-	CombatCollision->SetCollisionEnabled(ECollisionEnabled::NoCollision); /// to do not generate overlap events
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Weapon.h"
+#include "Main.h"
+#include "Components/SkeletalMeshComponent.h"
+#include "Engine/SkeletalMeshSocket.h"
+#include "Sound/SoundCue.h"
+#include "Kismet/GameplayStatics.h"
+#include "Particles/ParticleSystem.h"
+#include "Particles/ParticleSystemComponent.h"
+#include "Components/BoxComponent.h"
+#include "Enemy.h"
+#include "SpatialGridSubsystem.h"
+#include "CombatFXSubsystem.h"
+#include "MeleeTraceComponent.h"
+#include "GameplayPerf.h"
+
+AWeapon::AWeapon()
+{
+	SkeletalMesh = CreateDefaultSubobject<USkeletalMeshComponent>(TEXT("SkeletalMesh"));
+	SkeletalMesh->SetupAttachment(GetRootComponent());
+	bWeaponParticles = false;
+	WeaponState = EWeaponState::EWS_Pickup;
+
+	CombatCollision = CreateDefaultSubobject<UBoxComponent>(TEXT("CombatCollision"));
+	CombatCollision->SetupAttachment(GetRootComponent());
+
+	MeleeTrace = CreateDefaultSubobject<UMeleeTraceComponent>(TEXT("MeleeTrace"));
+	MeleeTrace->TargetClass = AEnemy::StaticClass();
+
+	Damage = 25.f;
+}
+
+void AWeapon::BeginPlay()
+{
+	Super::BeginPlay();
+
+	CombatCollision->SetCollisionEnabled(ECollisionEnabled::NoCollision); /// only its shape is used, swept by MeleeTrace
+
+	MeleeTrace->SetTraceShape(CombatCollision);
+	MeleeTrace->OnHit.BindUObject(this, &AWeapon::OnMeleeHit);
+}
+
+USceneComponent* AWeapon::GetVisualComponent() const
+{
+	return SkeletalMesh;
+}
+
+void AWeapon::OnOverlapBegin(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex, bool bFromSweep, const FHitResult& SweepResult)
+{
+	GAMEPLAY_PERF_SCOPE(WeaponOverlaps);
+	GAMEPLAY_PERF_COUNT_OVERLAP();
+
+	Super::OnOverlapBegin(OverlappedComponent, OtherActor, OtherComp, OtherBodyIndex, bFromSweep, SweepResult);
+
+	if ((WeaponState == EWeaponState::EWS_Pickup) && OtherActor) /// check if the item is valid and save it into the overlapping variable
+	{
+		AMain* Main = Cast<AMain>(OtherActor);
+
+		if (Main)
+		{
+			Main->SetActiveOverlappingItem(this);
+		}
+	}
+}
+
+void AWeapon::OnOverlapEnd(UPrimitiveComponent* OverlappedComponent, AActor* OtherActor, UPrimitiveComponent* OtherComp, int32 OtherBodyIndex)
+{
+	GAMEPLAY_PERF_SCOPE(WeaponOverlaps);
+	GAMEPLAY_PERF_COUNT_OVERLAP();
+
+	Super::OnOverlapEnd(OverlappedComponent, OtherActor, OtherComp, OtherBodyIndex);
+
+	if (OtherActor) /// check if the item is valid and save it into the overlapping variable
+	{
+		AMain* Main = Cast<AMain>(OtherActor);
+
+		if (Main)
+		{
+			Main->SetActiveOverlappingItem(nullptr); /// remove the item from the variable on leaving the sphere
+		}
+	}
+}
+
+void AWeapon::Equip(AMain* Char)
+{
+	if (Char)
+	{
+		SetInstegator(Char->GetController());
+
+		/// do not let the camera zoom if the sword is between the camera and the player
+		SkeletalMesh->SetCollisionResponseToChannel(ECollisionChannel::ECC_Camera, ECollisionResponse::ECR_Ignore);
+
+		/// disable collision between sword and pawn to let it keep moving
+		SkeletalMesh->SetCollisionResponseToChannel(ECollisionChannel::ECC_Pawn, ECollisionResponse::ECR_Ignore);
+
+		/// disable physics simulatin to attach the weapon to the player
+		SkeletalMesh->SetSimulatePhysics(false);
+
+		/// Get socket by name from engine and attach the USkeletalMeshSocket to it
+		const USkeletalMeshSocket* RightHandsocket = Char->GetMesh()->GetSocketByName("RightHandSocket");
+
+		/// check if the socket is valid and attach the skeletal mesh to it
+		if (RightHandsocket)
+		{
+			RightHandsocket->AttachActor(this, Char->GetMesh());
+			bRotate = false;
+			UpdateIdleRotation();
+
+			Char->SetEquippedWeapon(this); /// set the new weapon to the selected one
+			Char->SetActiveOverlappingItem(nullptr); /// remove the item from the variable on leaving the sphere
+			WeaponState = EWeaponState::EWS_Equipped; /// set status to equipped to disable overlapping again /// every Weapon_BP has it's own WeaponState, so it won't bug
+
+			if (USpatialGridSubsystem* SpatialGrid = GetWorld()->GetSubsystem<USpatialGridSubsystem>()) /// carried weapons are no longer items lying in the level
+			{
+				SpatialGrid->Unregister(this);
+			}
+		}
+
+		if (USoundCue* Sound = OnEquipSound.Get()) /// check if equip sound is set to a weapon and play it when player equip it
+		{
+			UGameplayStatics::PlaySound2D(this, Sound);
+		}
+
+		if (!bWeaponParticles) /// deactivate weapon particles upon equiping /// can be set from the editor to keep particles or no
+		{
+			IdleParticlesComponent->Deactivate();
+		}
+	}
+}
+
+void AWeapon::OnMeleeHit(const FHitResult& Hit)
+{
+	GAMEPLAY_PERF_SCOPE(MeleeHits);
+
+	if (AActor* OtherActor = Hit.GetActor())
+	{
+		AEnemy* Enemy = Cast<AEnemy>(OtherActor);
+
+		if (Enemy)
+		{
+			if (!Enemy->HitParticles.IsNull())
+			{
+				/// Spawn particles on the socket attached to weapon when hitting an enemy
+				const USkeletalMeshSocket* WeaponSocket = SkeletalMesh->GetSocketByName("WeaponSocket");
+				FVector SocketLocation = WeaponSocket ? WeaponSocket->GetSocketLocation(SkeletalMesh) : CombatCollision->GetComponentLocation();
+
+				UCombatFXSubsystem* FX = GetWorld()->GetSubsystem<UCombatFXSubsystem>();
+				if (FX)
+				{
+					/// pooled particles/sound, merged with other hits of this frame /// particles only when the socket exists like before
+					FX->PlayHitEffect(WeaponSocket ? Enemy->HitParticles.Get() : nullptr, Enemy->HitSound.Get(), SocketLocation); /// skipped while still streaming in
+				}
+				if (DamageTypeClass)
+				{
+					UGameplayStatics::ApplyDamage(Enemy, Damage, WeaponInstegator, this, DamageTypeClass);
+				}
+			}
+		}
+	}
+}
+
+void AWeapon::ActivateCollision()
+{
+	MeleeTrace->BeginSwing(); /// every enemy on the blade's path is hit once
+}
+
+void AWeapon::DeActivateCollision()
+{
+	MeleeTrace->EndSwing();
 }
\ No newline at end of file
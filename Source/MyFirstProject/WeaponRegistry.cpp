@@ -0,0 +1,33 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "WeaponRegistry.h"
+#include "Engine/AssetManager.h"
+#include "Weapon.h"
+
+TSoftClassPtr<AWeapon> UWeaponRegistry::FindWeapon(FName WeaponName) const
+{
+	const TSoftClassPtr<AWeapon>* WeaponClass = Weapons.Find(WeaponName);
+	return WeaponClass ? *WeaponClass : TSoftClassPtr<AWeapon>();
+}
+
+TSharedPtr<FStreamableHandle> UWeaponRegistry::RequestWeaponClass(FName WeaponName, FOnWeaponClassLoaded OnLoaded) const
+{
+	const TSoftClassPtr<AWeapon> WeaponClass = FindWeapon(WeaponName);
+
+	if (WeaponClass.IsNull())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("No weapon named %s in %s"), *WeaponName.ToString(), *GetName());
+		return nullptr;
+	}
+
+	if (WeaponClass.Get())
+	{
+		OnLoaded.ExecuteIfBound(WeaponClass.Get());
+		return nullptr;
+	}
+
+	return UAssetManager::GetStreamableManager().RequestAsyncLoad(WeaponClass.ToSoftObjectPath(), FStreamableDelegate::CreateLambda([WeaponClass, OnLoaded]()
+	{
+		OnLoaded.ExecuteIfBound(WeaponClass.Get());
+	}));
+}
\ No newline at end of file
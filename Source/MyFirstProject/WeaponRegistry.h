@@ -0,0 +1,33 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "WeaponRegistry.generated.h"
+
+DECLARE_DELEGATE_OneParam(FOnWeaponClassLoaded, TSubclassOf<class AWeapon>);
+
+/**
+ * Every weapon that can be saved and restored, by the name stored in the save game
+ * The classes are soft references so the registry can be loaded without pulling every weapon into memory
+ */
+UCLASS(BlueprintType)
+class MYFIRSTPROJECT_API UWeaponRegistry: public UPrimaryDataAsset
+{
+	GENERATED_BODY()
+
+public:
+
+	/// Weapon classes by AWeapon::Name
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "SaveData")
+		TMap<FName, TSoftClassPtr<AWeapon>> Weapons;
+
+	TSoftClassPtr<AWeapon> FindWeapon(FName WeaponName) const;
+
+	/**
+	* Stream the weapon class in through the asset manager and call OnLoaded with it, right away if it's in memory already
+	* @Return handle of the running load, keep it to cancel the request, null if nothing had to load
+	*/
+	TSharedPtr<struct FStreamableHandle> RequestWeaponClass(FName WeaponName, FOnWeaponClassLoaded OnLoaded) const;
+};